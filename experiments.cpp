@@ -0,0 +1,476 @@
+#include <bits/stdc++.h>
+#include "hitting_set.h"
+#include "ilp_model.h"
+using namespace std;
+
+// In-process experiment suite. Generates every test graph in memory (same RNG
+// sequence as gen_graphs.cpp, so a seed gives the same graph), runs the
+// approximation algorithm and the GLPK ILP of hitting_set.h / ilp_model.h
+// concurrently on a thread pool, and writes experiment_results.txt and
+// TEST_RESULTS_CHART.md in the format run_experiments.sh used to assemble.
+//
+// Usage:
+//   experiments [--threads N] [--seeds K] [--approx-timeout S] [--ilp-timeout S] [--memory-mb M]
+//     --seeds K          run every configuration with K seeds (seed, seed + 1, ...)
+//     --approx-timeout S per-task wall-clock budget of the approximation (default 30)
+//     --ilp-timeout S    per-task time limit of the ILP (default 120)
+//     --memory-mb M      per-task memory limit (default 1024). The approximation
+//                        allocates nothing but the graph and its solver workspace,
+//                        so it is held to the limit up front: a test whose estimate
+//                        exceeds it is skipped, and nothing is checked while it runs.
+//                        The ILP is capped at run time via glp_mem_limit; a solve
+//                        that hits the cap is reported as "ERROR (memory limit)".
+
+// The generator of gen_graphs.cpp, writing into a Graph instead of a file.
+Graph generate_graph(int n, int m, double p, unsigned seed, size_t &num_edges)
+{
+    mt19937 rng(seed == 0 ? random_device{}() : seed);
+    uniform_real_distribution<double> ud(0.0, 1.0);
+
+    vector<pair<int, int>> edges;
+    for (int r = 0; r < m; ++r)
+    {
+        bool any_in_range = false;
+        for (int v = 0; v < n; ++v)
+        {
+            if (ud(rng) < p)
+            {
+                edges.emplace_back(r, v);
+                any_in_range = true;
+            }
+        }
+        if (!any_in_range)
+        {
+            int v = rng() % n;
+            edges.emplace_back(r, v);
+        }
+    }
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    Graph graph(n, m);
+    for (auto &e : edges)
+        graph.add_edge(e.first, e.second);
+    num_edges = edges.size();
+    return graph;
+}
+
+struct TestConfig
+{
+    string category;
+    string name;
+    int n;
+    int m;
+    double p;
+    unsigned seed;
+};
+
+struct TestResult
+{
+    size_t edges = 0;
+    bool generated = false;
+    string approx_status; // empty on success
+    size_t approx_size = 0;
+    double approx_time = 0.0;
+    string ilp_status = "NOT RUN";
+    int ilp_size = 0;
+    double ilp_time = 0.0;
+};
+
+// bc-style truncation to a fixed number of decimals, as run_experiments.sh printed.
+string truncated(double value, int decimals)
+{
+    double scale = pow(10.0, decimals);
+    ostringstream out;
+    out << fixed << setprecision(decimals) << floor(value * scale + 1e-9) / scale;
+    return out.str();
+}
+
+// A time in seconds with nine decimals, as `date +%s.%N` differences printed. Formatted
+// aside so that the fixed/precision flags do not stick to the report streams.
+string seconds(double value)
+{
+    ostringstream out;
+    out << fixed << setprecision(9) << value;
+    return out.str();
+}
+
+// The ILP is skipped above this many points, as in run_experiments.sh.
+static const int ILP_MAX_POINTS = 200;
+
+int main(int argc, char **argv)
+{
+    int num_threads = max(1u, thread::hardware_concurrency());
+    int num_seeds = 1;
+    double approx_timeout = 30.0;
+    double ilp_timeout = 120.0;
+    int memory_mb = 1024;
+    for (int a = 1; a < argc; ++a)
+    {
+        string arg = argv[a];
+        if (a + 1 >= argc)
+        {
+            cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        if (arg == "--threads")
+            num_threads = max(1, atoi(argv[++a]));
+        else if (arg == "--seeds")
+            num_seeds = max(1, atoi(argv[++a]));
+        else if (arg == "--approx-timeout")
+            approx_timeout = atof(argv[++a]);
+        else if (arg == "--ilp-timeout")
+            ilp_timeout = atof(argv[++a]);
+        else if (arg == "--memory-mb")
+            memory_mb = max(1, atoi(argv[++a]));
+        else
+        {
+            cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    const vector<TestConfig> base_configs = {
+        {"TINY TEST CASES", "Tiny Dense", 10, 5, 0.5, 1001},
+        {"TINY TEST CASES", "Tiny Medium Density", 15, 8, 0.3, 1002},
+        {"TINY TEST CASES", "Tiny Sparse", 20, 10, 0.2, 1003},
+        {"SMALL TEST CASES", "Small Dense", 50, 20, 0.1, 2001},
+        {"SMALL TEST CASES", "Small Medium Density", 50, 25, 0.05, 2002},
+        {"SMALL TEST CASES", "Small Sparse", 60, 30, 0.03, 2003},
+        {"MEDIUM TEST CASES", "Medium Dense", 100, 50, 0.05, 3001},
+        {"MEDIUM TEST CASES", "Medium Medium Density", 120, 60, 0.03, 3002},
+        {"MEDIUM TEST CASES", "Medium Sparse", 150, 75, 0.02, 3003},
+        {"LARGE TEST CASES (Approximation Only)", "Large Sparse", 300, 150, 0.02, 4001},
+        {"LARGE TEST CASES (Approximation Only)", "Very Large Sparse", 500, 200, 0.015, 4002},
+        {"LARGE TEST CASES (Approximation Only)", "Extra Large Sparse", 1000, 400, 0.01, 4003},
+        {"SPECIAL STRUCTURE TEST CASES", "Many Points, Few Ranges", 100, 20, 0.1, 5001},
+        {"SPECIAL STRUCTURE TEST CASES", "Few Points, Many Ranges", 50, 100, 0.1, 5002},
+        {"SPECIAL STRUCTURE TEST CASES", "Balanced Graph", 80, 80, 0.05, 5003},
+    };
+    vector<TestConfig> configs;
+    for (const auto &config : base_configs)
+    {
+        for (int k = 0; k < num_seeds; ++k)
+        {
+            TestConfig c = config;
+            c.seed += k;
+            if (num_seeds > 1)
+                c.name += " (seed " + to_string(c.seed) + ")";
+            configs.push_back(c);
+        }
+    }
+
+    // Graphs are generated by the pool too; each test's solver tasks wait on its graph.
+    size_t num_tests = configs.size();
+    vector<TestResult> results(num_tests);
+    vector<unique_ptr<Graph>> graphs(num_tests);
+    vector<once_flag> generated(num_tests);
+    auto graph_for = [&](size_t t) -> const Graph *
+    {
+        call_once(generated[t], [&]()
+                  {
+                      const TestConfig &c = configs[t];
+                      // vector<vector<int>> plus the edge list during generation, and the
+                      // solver workspace (weights, net and per-point / per-range stamps)
+                      double estimate_mb = (c.n * (double)c.m * c.p * 12.0 + c.m * 24.0 + c.n * 24.0 +
+                                            c.n * 16.0 + c.m * 4.0) /
+                                           (1 << 20);
+                      if (estimate_mb > memory_mb)
+                          return;
+                      graphs[t].reset(new Graph(generate_graph(c.n, c.m, c.p, c.seed, results[t].edges)));
+                      results[t].generated = true; });
+        return graphs[t].get();
+    };
+
+    // Task 2t runs the approximation on test t, task 2t + 1 its ILP.
+    atomic<size_t> next_task(0);
+    mutex print_mu;
+    auto worker = [&]()
+    {
+        SolverWorkspace workspace;
+        ostream null_log(nullptr);
+        size_t task;
+        while ((task = next_task++) < 2 * num_tests)
+        {
+            size_t t = task / 2;
+            const TestConfig &c = configs[t];
+            TestResult &r = results[t];
+            const Graph *graph = graph_for(t);
+            if (!graph)
+            {
+                if (task % 2 == 0)
+                    r.approx_status = "SKIPPED (memory limit)";
+                continue;
+            }
+
+            if (task % 2 == 0)
+            {
+                auto start = chrono::steady_clock::now();
+                HittingSetSolver solver(*graph, workspace);
+                solver.set_log(null_log);
+                solver.set_deadline(start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(approx_timeout)));
+                auto hitting_set = solver.find_hitting_set();
+                r.approx_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                if (hitting_set)
+                    r.approx_size = hitting_set->size();
+                else
+                    r.approx_status = solver.timed_out() ? "approximation timeout" : "no solution";
+            }
+            else if (c.n <= ILP_MAX_POINTS)
+            {
+                auto start = chrono::steady_clock::now();
+                IlpLimits limits;
+                limits.time_limit_ms = static_cast<int>(ilp_timeout * 1000);
+                limits.memory_limit_mb = memory_mb;
+                unordered_set<int> optimal_set;
+                IlpStatus status = solve_hitting_set_ilp(*graph, limits, optimal_set);
+                r.ilp_size = optimal_set.size();
+                r.ilp_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                r.ilp_status = status == ILP_SUCCESS        ? "SUCCESS"
+                               : status == ILP_TIMEOUT      ? "TIMEOUT"
+                               : status == ILP_MEMORY_LIMIT ? "ERROR (memory limit)"
+                                                            : "ERROR";
+            }
+            else
+                r.ilp_status = "SKIPPED (too large)";
+
+            lock_guard<mutex> lock(print_mu);
+            cout << "  finished " << (task % 2 == 0 ? "approximation" : "ILP") << " for Test #" << t + 1
+                 << ": " << c.name << endl;
+        }
+        glp_free_env();
+    };
+
+    cout << "Starting experiment suite: " << num_tests << " tests on " << num_threads << " thread(s)..." << endl;
+    vector<thread> pool;
+    for (int w = 0; w < num_threads; ++w)
+        pool.emplace_back(worker);
+    for (auto &th : pool)
+        th.join();
+
+    time_t now = time(nullptr);
+    char timestamp[64];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+
+    // experiment_results.txt
+    ofstream out("experiment_results.txt");
+    out << "========================================\n";
+    out << "Hitting Set Algorithm Experiment Results\n";
+    out << "Run Date: " << timestamp << "\n";
+    out << "========================================\n\n";
+
+    int successful_ilp = 0, failed_ilp = 0;
+    double total_ratio = 0.0;
+    vector<string> ratio_text(num_tests, "N/A");
+    vector<bool> reported(num_tests, false);
+    string category;
+    for (size_t t = 0; t < num_tests; ++t)
+    {
+        const TestConfig &c = configs[t];
+        TestResult &r = results[t];
+        if (c.category != category)
+        {
+            category = c.category;
+            out << "=== " << category << " ===\n\n";
+        }
+        if (!r.generated || !r.approx_status.empty())
+        {
+            string reason = !r.generated ? "generation skipped, memory limit" : r.approx_status;
+            out << "Test #" << t + 1 << ": " << c.name << " - FAILED (" << reason << ")\n\n";
+            continue;
+        }
+        reported[t] = true;
+
+        if (r.ilp_status == "SUCCESS" && r.ilp_size > 0)
+        {
+            ratio_text[t] = truncated((double)r.approx_size / r.ilp_size, 4);
+            total_ratio += stod(ratio_text[t]);
+            successful_ilp++;
+        }
+        else if (r.ilp_status == "TIMEOUT" || r.ilp_status.rfind("ERROR", 0) == 0)
+            failed_ilp++;
+
+        out << "----------------------------------------\n";
+        out << "Test #" << t + 1 << ": " << c.name << "\n";
+        out << "----------------------------------------\n";
+        out << "Graph Parameters:\n";
+        out << "  - Points (n):        " << c.n << "\n";
+        out << "  - Ranges (m):        " << c.m << "\n";
+        out << "  - Edge Probability:  " << c.p << "\n";
+        out << "  - Actual Edges:      " << r.edges << "\n";
+        out << "  - Random Seed:       " << c.seed << "\n\n";
+        out << "Results:\n";
+        out << "  - Approximation Size:  " << r.approx_size << "\n";
+        out << "  - Approximation Time:  " << seconds(r.approx_time) << "s\n";
+        out << "  - ILP Optimal Size:    " << (r.ilp_status == "SUCCESS" ? to_string(r.ilp_size) : "N/A") << "\n";
+        if (r.ilp_status == "SUCCESS")
+            out << "  - ILP Time:            " << seconds(r.ilp_time) << "\n";
+        else if (r.ilp_status == "TIMEOUT")
+            out << "  - ILP Time:            >" << ilp_timeout << "s\n";
+        else
+            out << "  - ILP Time:            N/A\n";
+        out << "  - ILP Status:          " << r.ilp_status << "\n";
+        if (ratio_text[t] != "N/A")
+            out << "  - Approximation Ratio: " << ratio_text[t] << "\n";
+        out << "\n";
+    }
+
+    int total_tests = static_cast<int>(num_tests);
+    string avg_ratio = successful_ilp > 0 ? truncated(total_ratio / successful_ilp, 4) : "N/A";
+    out << "========================================\n";
+    out << "SUMMARY STATISTICS\n";
+    out << "========================================\n\n";
+    out << "Total Tests Run:           " << total_tests << "\n";
+    out << "ILP Successful:            " << successful_ilp << "\n";
+    out << "ILP Failed/Timeout:        " << failed_ilp << "\n\n";
+    if (successful_ilp > 0)
+    {
+        out << "Average Approximation Ratio: " << avg_ratio << "\n\n";
+        out << "Interpretation:\n";
+        out << "  - Ratio = 1.0:  Approximation found optimal solution\n";
+        out << "  - Ratio < 2.0:  Excellent approximation\n";
+        out << "  - Ratio < 3.0:  Good approximation\n";
+        out << "  - Ratio < O(log n): Within theoretical bound\n";
+    }
+    out << "\n";
+    out << "========================================\n";
+    out << "ANALYSIS\n";
+    out << "========================================\n\n";
+    out << "Key Observations:\n\n";
+    out << "1. Scalability:\n";
+    out << "   - Approximation algorithm handles graphs with 1000+ points\n";
+    out << "   - ILP solver practical only for graphs with <200 points\n\n";
+    out << "2. Quality vs Speed Trade-off:\n";
+    out << "   - Approximation: Fast but larger solution\n";
+    out << "   - ILP: Optimal but exponentially slower\n\n";
+    out << "3. Approximation Quality:\n";
+    out << "   - Typically within 1.5-2x of optimal on random graphs\n";
+    out << "   - Sometimes finds optimal solution\n";
+    out << "   - Always within O(log n) theoretical guarantee\n\n";
+    out.close();
+
+    // TEST_RESULTS_CHART.md
+    ofstream chart("TEST_RESULTS_CHART.md");
+    chart << "# Quick Reference: Test Results at a Glance\n\n";
+    chart << "**Generated:** " << timestamp << "\n\n";
+    chart << "## All Test Cases - Approximation Ratios\n\n";
+    chart << "| # | Test Name | n | m | Edges | Approx | Optimal | Ratio | Time(s) |\n";
+    chart << "|---|-----------|---|---|-------|--------|---------|-------|---------|\n";
+    for (size_t t = 0; t < num_tests; ++t)
+    {
+        if (!reported[t])
+            continue;
+        const TestConfig &c = configs[t];
+        const TestResult &r = results[t];
+        string ratio_display = ratio_text[t];
+        if (ratio_display != "N/A" && stod(ratio_display) < 1.10)
+            ratio_display = "**" + ratio_display + "** ⭐";
+        chart << "| " << t + 1 << " | " << c.name << " | " << c.n << " | " << c.m << " | " << r.edges << " | "
+              << r.approx_size << " | " << (r.ilp_status == "SUCCESS" ? to_string(r.ilp_size) : "N/A") << " | "
+              << ratio_display << " | " << seconds(r.approx_time) << " |\n";
+    }
+    chart << "\n⭐ = Near-optimal (ratio < 1.10)\n\n";
+
+    chart << "## Statistics Summary\n\n```\n";
+    chart << "Total Tests:                    " << total_tests << "\n";
+    chart << "Tests with ILP comparison:      " << successful_ilp << "\n";
+    chart << "Tests approximation only:       " << total_tests - successful_ilp << "\n\n";
+    if (successful_ilp > 0)
+    {
+        size_t best = num_tests, worst = num_tests;
+        for (size_t t = 0; t < num_tests; ++t)
+        {
+            if (ratio_text[t] == "N/A")
+                continue;
+            if (best == num_tests || stod(ratio_text[t]) < stod(ratio_text[best]))
+                best = t;
+            if (worst == num_tests || stod(ratio_text[t]) > stod(ratio_text[worst]))
+                worst = t;
+        }
+        chart << "Average Approximation Ratio:    " << avg_ratio << "x\n";
+        chart << "Best Ratio:                     " << ratio_text[best] << "x  (#" << best + 1 << " - " << configs[best].name << ")\n";
+        chart << "Worst Ratio:                    " << ratio_text[worst] << "x  (#" << worst + 1 << " - " << configs[worst].name << ")\n";
+    }
+    chart << "\n";
+
+    size_t fastest = num_tests, slowest = num_tests;
+    int max_ilp_n = 0, max_approx_n = 0;
+    for (size_t t = 0; t < num_tests; ++t)
+    {
+        if (!reported[t])
+            continue;
+        if (fastest == num_tests || results[t].approx_time < results[fastest].approx_time)
+            fastest = t;
+        if (slowest == num_tests || results[t].approx_time > results[slowest].approx_time)
+            slowest = t;
+        if (results[t].ilp_status == "SUCCESS")
+            max_ilp_n = max(max_ilp_n, configs[t].n);
+        max_approx_n = max(max_approx_n, configs[t].n);
+    }
+    if (fastest < num_tests)
+    {
+        chart << "Fastest Test:                   " << seconds(results[fastest].approx_time)
+              << "s (#" << fastest + 1 << " - " << configs[fastest].name << ")\n";
+        chart << "Slowest Test:                   " << seconds(results[slowest].approx_time)
+              << "s (#" << slowest + 1 << " - " << configs[slowest].name << ")\n\n";
+    }
+    chart << "Max graph size solved by ILP:   " << max_ilp_n << " points\n";
+    chart << "Max graph size by approx:       " << max_approx_n << " points\n";
+    chart << "```\n\n";
+
+    chart << "## Performance Trends\n\n";
+    chart << "### Approximation Time vs Graph Size\n```\n";
+    for (size_t t = 0; t < num_tests; ++t)
+        if (reported[t])
+            chart << "n=" << configs[t].n << "     → " << seconds(results[t].approx_time) << "s\n";
+    chart << "\nGrowth: Roughly linear (polynomial time)\n```\n\n";
+
+    chart << "## Quality Breakdown\n\n";
+    if (successful_ilp > 0)
+    {
+        int excellent = 0, good = 0, acceptable = 0, outside = 0;
+        for (size_t t = 0; t < num_tests; ++t)
+        {
+            if (ratio_text[t] == "N/A")
+                continue;
+            double ratio = stod(ratio_text[t]);
+            if (ratio < 1.30)
+                excellent++;
+            else if (ratio < 1.50)
+                good++;
+            else if (ratio < 2.00)
+                acceptable++;
+            else
+                outside++;
+        }
+        auto pct = [&](int count)
+        { return truncated(100.0 * count / successful_ilp, 1); };
+        chart << "### Excellent (Ratio < 1.3): " << excellent << " tests (" << pct(excellent) << "%)\n";
+        chart << "### Good (1.3 ≤ Ratio < 1.5): " << good << " tests (" << pct(good) << "%)\n";
+        chart << "### Acceptable (1.5 ≤ Ratio < 2.0): " << acceptable << " tests (" << pct(acceptable) << "%)\n";
+        chart << "### Outside Bound (Ratio ≥ 2.0): " << outside << " tests (" << pct(outside) << "%)\n\n";
+        if (outside == 0)
+            chart << "All results well within theoretical guarantee!\n";
+    }
+    chart << "\n## Key Insights\n\n";
+    chart << "1. **Sparse graphs** tend to produce better approximation ratios\n";
+    chart << "2. **Graph structure** matters more than absolute size\n";
+    chart << "3. **All ratios** far better than O(log n) worst-case guarantee\n";
+    chart << "4. **Approximation algorithm** scales to large graphs where ILP fails\n\n";
+    chart << "---\n\n";
+    chart << "*Auto-generated from `run_experiments.sh`*  \n";
+    chart << "*See `experiment_results.txt` for detailed raw data*\n";
+    chart.close();
+
+    cout << "\n=========================================\n";
+    cout << "Experiment complete!\n";
+    cout << "Results written to: experiment_results.txt\n";
+    cout << "Chart generated: TEST_RESULTS_CHART.md\n";
+    cout << "=========================================\n\n";
+    cout << "Summary:\n";
+    cout << "  Total tests: " << total_tests << "\n";
+    cout << "  ILP successful: " << successful_ilp << "\n";
+    if (successful_ilp > 0)
+        cout << "  Average approximation ratio: " << avg_ratio << "\n";
+    return 0;
+}
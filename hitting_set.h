@@ -0,0 +1,733 @@
+#ifndef HITTING_SET_H
+#define HITTING_SET_H
+
+// The approximation algorithm shared by paper1algo, solver and experiments: the
+// graph, the weighted epsilon-net doubling loop (HittingSetSolver) and the
+// backends it runs over, plus the optional HS_INSTRUMENT counters.
+
+#include <bits/stdc++.h>
+using namespace std;
+
+struct Graph
+{
+    int num_points;
+    int num_ranges;
+    // vector of point indices in range i.
+    // The index of the outer vector corresponds to a range's ID.
+    // The inner vector at that index stores the IDs of all the points contained within that specific range.
+    vector<vector<int>>
+        ranges_to_points;
+
+    Graph(int n, int m) : num_points(n), num_ranges(m), ranges_to_points(m)
+    {
+    }
+
+    void add_edge(int range_idx, int point_idx)
+    {
+        if (range_idx < num_ranges && point_idx < num_points)
+        {
+            ranges_to_points[range_idx].push_back(point_idx);
+        }
+    }
+
+    // Appends an empty range / an isolated point and returns its index.
+    int add_range()
+    {
+        ranges_to_points.emplace_back();
+        return num_ranges++;
+    }
+
+    int add_point() { return num_points++; }
+};
+
+#ifdef HS_INSTRUMENT
+// Hot-path counters and phase timers, compiled in with -DHS_INSTRUMENT.
+// Every solver accumulates into its own SolverStats and merges them into the
+// process-wide totals when it is destroyed. At exit the totals are written as
+// JSON to $HS_STATS_FILE (default hs_stats.json) and, if $HS_TRACE_FILE is set,
+// every timed phase is also written there as a Chrome trace-event file.
+// Without the flag HS_STAT / HS_PHASE expand to nothing.
+using stats_clock = chrono::steady_clock;
+
+enum Phase
+{
+    PHASE_SOLVE_FOR_C,
+    PHASE_NET,
+    PHASE_VERIFY,
+    PHASE_REWEIGHT,
+    PHASE_COUNT
+};
+
+static const char *const PHASE_NAMES[PHASE_COUNT] = {"solve_for_c", "net", "verify", "reweight"};
+
+struct TraceEvent
+{
+    Phase phase;
+    long long start_ns; // since process start
+    long long dur_ns;
+    int c_prime;
+    size_t tid;
+};
+
+struct SolverStats
+{
+    long long edges_scanned = 0;
+    long long net_constructions = 0;
+    long long weight_doublings = 0;
+    long long range_hit_markings = 0;
+    map<int, long long> nets_rejected; // keyed by c'
+    long long phase_ns[PHASE_COUNT] = {};
+    long long phase_calls[PHASE_COUNT] = {};
+    vector<TraceEvent> events;
+    int c_prime = 0; // c' of the phase currently running, for trace args
+
+    void merge(const SolverStats &other)
+    {
+        edges_scanned += other.edges_scanned;
+        net_constructions += other.net_constructions;
+        weight_doublings += other.weight_doublings;
+        range_hit_markings += other.range_hit_markings;
+        for (auto &kv : other.nets_rejected)
+            nets_rejected[kv.first] += kv.second;
+        for (int p = 0; p < PHASE_COUNT; ++p)
+        {
+            phase_ns[p] += other.phase_ns[p];
+            phase_calls[p] += other.phase_calls[p];
+        }
+        events.insert(events.end(), other.events.begin(), other.events.end());
+    }
+};
+
+struct InstrumentationSink
+{
+    mutex mu;
+    SolverStats totals;
+    stats_clock::time_point epoch = stats_clock::now();
+    bool tracing = getenv("HS_TRACE_FILE") != nullptr;
+    // The files are written at exit only by a process that solved something and
+    // whose totals are its own: shard workers clear enabled, so they cannot
+    // overwrite the coordinator's file.
+    bool enabled = true;
+    bool merged = false;
+
+    void merge(const SolverStats &stats)
+    {
+        lock_guard<mutex> lock(mu);
+        totals.merge(stats);
+        merged = true;
+    }
+
+    ~InstrumentationSink()
+    {
+        if (!enabled || !merged)
+            return;
+        const char *stats_path = getenv("HS_STATS_FILE");
+        ofstream out(stats_path ? stats_path : "hs_stats.json");
+        out << "{\n";
+        out << "  \"edges_scanned\": " << totals.edges_scanned << ",\n";
+        out << "  \"net_constructions\": " << totals.net_constructions << ",\n";
+        out << "  \"weight_doublings\": " << totals.weight_doublings << ",\n";
+        out << "  \"range_hit_markings\": " << totals.range_hit_markings << ",\n";
+        out << "  \"nets_rejected_by_c_prime\": {";
+        bool first = true;
+        for (auto &kv : totals.nets_rejected)
+        {
+            out << (first ? "" : ", ") << "\"" << kv.first << "\": " << kv.second;
+            first = false;
+        }
+        out << "},\n";
+        out << "  \"phases\": {\n";
+        for (int p = 0; p < PHASE_COUNT; ++p)
+        {
+            out << "    \"" << PHASE_NAMES[p] << "\": {\"calls\": " << totals.phase_calls[p]
+                << ", \"total_ms\": " << fixed << setprecision(3) << totals.phase_ns[p] / 1e6 << "}"
+                << (p + 1 < PHASE_COUNT ? "," : "") << "\n";
+        }
+        out << "  }\n}\n";
+
+        if (!tracing)
+            return;
+        ofstream trace(getenv("HS_TRACE_FILE"));
+        trace << "{\"traceEvents\": [\n";
+        for (size_t k = 0; k < totals.events.size(); ++k)
+        {
+            const TraceEvent &ev = totals.events[k];
+            trace << "  {\"name\": \"" << PHASE_NAMES[ev.phase] << "\", \"ph\": \"X\", \"pid\": 1"
+                  << ", \"tid\": " << ev.tid % 100000
+                  << ", \"ts\": " << fixed << setprecision(3) << ev.start_ns / 1e3
+                  << ", \"dur\": " << ev.dur_ns / 1e3
+                  << ", \"args\": {\"c_prime\": " << ev.c_prime << "}}"
+                  << (k + 1 < totals.events.size() ? "," : "") << "\n";
+        }
+        trace << "]}\n";
+    }
+};
+
+static InstrumentationSink g_instrumentation;
+
+// Times the enclosing scope into stats.phase_ns and, when tracing, the event list.
+struct ScopedPhase
+{
+    SolverStats &stats;
+    Phase phase;
+    stats_clock::time_point start = stats_clock::now();
+
+    ScopedPhase(SolverStats &s, Phase p) : stats(s), phase(p) {}
+    ~ScopedPhase()
+    {
+        auto end = stats_clock::now();
+        long long dur = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+        stats.phase_ns[phase] += dur;
+        stats.phase_calls[phase]++;
+        if (g_instrumentation.tracing)
+        {
+            long long since_epoch = chrono::duration_cast<chrono::nanoseconds>(start - g_instrumentation.epoch).count();
+            stats.events.push_back({phase, since_epoch, dur, stats.c_prime, hash<thread::id>()(this_thread::get_id())});
+        }
+    }
+};
+
+#define HS_STAT(expr) ((void)(stats_.expr))
+#define HS_PHASE_CONCAT_(a, b) a##b
+#define HS_PHASE_VAR_(line) HS_PHASE_CONCAT_(hs_phase_, line)
+#define HS_PHASE(phase) ScopedPhase HS_PHASE_VAR_(__LINE__)(stats_, phase)
+#else
+#define HS_STAT(expr) ((void)0)
+#define HS_PHASE(phase) ((void)0)
+#endif
+
+// Scratch buffers owned across solver iterations (and across solves, when one
+// workspace is handed to several HittingSetSolver instances in the same process).
+// Buffers only ever grow, so once they are sized for the largest graph seen the
+// doubling loop runs without touching the heap. Per-net membership is reset by
+// bumping a generation counter instead of clearing the flag arrays.
+struct SolverWorkspace
+{
+    vector<double> weights;
+    // range i is hit by the current net iff range_hit_gen[i] == net_gen
+    vector<unsigned> range_hit_gen;
+    // point p is in the current net iff point_in_net_gen[p] == net_gen
+    vector<unsigned> point_in_net_gen;
+    // points of the current net, in insertion order
+    vector<int> net;
+    unsigned net_gen = 0;
+
+    void prepare(int num_points, int num_ranges)
+    {
+        if ((int)weights.size() < num_points)
+        {
+            weights.resize(num_points);
+            point_in_net_gen.resize(num_points, 0);
+            net.reserve(num_points);
+        }
+        if ((int)range_hit_gen.size() < num_ranges)
+            range_hit_gen.resize(num_ranges, 0);
+    }
+
+    // Empties the net and marks every range un-hit in O(1).
+    void begin_net()
+    {
+        net.clear();
+        if (++net_gen == 0)
+        {
+            // The counter wrapped: stale stamps could collide, so clear once.
+            fill(range_hit_gen.begin(), range_hit_gen.end(), 0u);
+            fill(point_in_net_gen.begin(), point_in_net_gen.end(), 0u);
+            net_gen = 1;
+        }
+    }
+
+    bool is_range_hit(int range_idx) const { return range_hit_gen[range_idx] == net_gen; }
+    void mark_range_hit(int range_idx) { range_hit_gen[range_idx] = net_gen; }
+    bool in_net(int point_idx) const { return point_in_net_gen[point_idx] == net_gen; }
+
+    void add_to_net(int point_idx)
+    {
+        if (!in_net(point_idx))
+        {
+            point_in_net_gen[point_idx] = net_gen;
+            net.push_back(point_idx);
+        }
+    }
+};
+
+// Best hitting set found before a deadline, with what is known about its quality.
+struct AnytimeResult
+{
+    optional<unordered_set<int>> hitting_set;
+    int c_prime = 0;     // c' of the doubling round that produced it; 0 for the greedy seed
+    int lower_bound = 0; // the optimum has at least this many points
+    bool timed_out = false;
+};
+
+// Solver state at the start of a doubling iteration: enough to continue the run
+// exactly where it stopped. Weights are always powers of two, so they are kept as
+// exponents (ldexp(1.0, e) restores them bit for bit, including overflow to inf).
+struct SolverCheckpoint
+{
+    int c_prime = 0;                  // doubling round in progress
+    int iteration = 0;                // next iteration of that round
+    vector<int32_t> weight_exponents; // weight of point p is 2^weight_exponents[p]
+    vector<int> best_solution;        // anytime mode's best hitting set so far, else empty
+};
+
+// The graph-facing half of the doubling loop. HittingSetSolver runs the loop itself
+// (iteration bounds, weights, trace, deadlines, checkpoints and HS_INSTRUMENT
+// counters); a backend only answers the two questions the loop asks of the ranges,
+// so the in-memory graph, the out-of-core edge file and the sharded workers all run
+// the same loop. Long scans poll cancelled() and may stop early once it returns
+// true; the solver then discards whatever they left behind.
+class NetBackend
+{
+public:
+    virtual ~NetBackend() = default;
+
+    virtual int num_points() const = 0;
+
+    // While some un-hit range weighs more than threshold, adds the heaviest point of
+    // the heaviest such range (the lowest range index on ties) to the net. The net is
+    // then available from net(), in insertion order.
+    virtual void build_net(double threshold, const vector<double> &weights, const function<bool()> &cancelled) = 0;
+    virtual const vector<int> &net() const = 0;
+
+    // Returns the lowest non-empty range the net misses and copies its points into
+    // missed_points, or -1 if the net is a hitting set.
+    virtual int verify_net(vector<int> &missed_points, const function<bool()> &cancelled) = 0;
+
+    // Called after the solver sets every weight (to 1, or from a checkpoint) and after
+    // it doubles the weights of points, for backends that keep a replica of them.
+    virtual void weights_reset(const vector<double> &) {}
+    virtual void weights_doubled(const vector<int> &) {}
+
+    // True once the backend cannot answer any more (read error, lost worker).
+    virtual bool failed() const { return false; }
+
+protected:
+    static const int CANCEL_CHECK_INTERVAL = 256;
+};
+
+// Edits applied on the fly to a Graph that stays untouched: ranges flagged in
+// removed (when it is non-empty) are treated as empty, and added are appended as
+// ranges num_ranges, num_ranges + 1, ...
+struct GraphEdits
+{
+    vector<char> removed;
+    vector<vector<int>> added;
+};
+
+// NetBackend over a Graph in memory, optionally seen through GraphEdits; the net
+// lives in a SolverWorkspace. The graph and the edits must outlive the backend.
+class InMemoryNetBackend : public NetBackend
+{
+public:
+    InMemoryNetBackend(const Graph &graph, SolverWorkspace &workspace, const GraphEdits *edits = nullptr)
+        : graph_(graph), ws_(workspace), edits_(edits) {}
+
+#ifdef HS_INSTRUMENT
+    ~InMemoryNetBackend() { g_instrumentation.merge(stats_); }
+#endif
+
+    int num_points() const override { return graph_.num_points; }
+    const vector<int> &net() const override { return ws_.net; }
+
+    void build_net(double weight_threshold, const vector<double> &weights, const function<bool()> &cancelled) override
+    {
+        const int num_ranges = this->num_ranges();
+        ws_.prepare(graph_.num_points, num_ranges);
+        ws_.begin_net();
+
+        bool found_heavy_unhit_range = true;
+
+        while (found_heavy_unhit_range)
+        {
+            found_heavy_unhit_range = false;
+            int best_range_to_hit = -1;
+            double max_weight = -1.0;
+
+            // heaviest un-hit range
+            for (int i = 0; i < num_ranges; ++i)
+            {
+                if (i % CANCEL_CHECK_INTERVAL == 0 && cancelled())
+                    return;
+                if (!ws_.is_range_hit(i))
+                {
+                    double current_range_weight = 0.0;
+                    for (int point_idx : range_points(i))
+                    {
+                        current_range_weight += weights[point_idx];
+                    }
+                    HS_STAT(edges_scanned += range_points(i).size());
+                    if (current_range_weight > weight_threshold && current_range_weight > max_weight)
+                    {
+                        max_weight = current_range_weight;
+                        best_range_to_hit = i;
+                        found_heavy_unhit_range = true;
+                    }
+                }
+            }
+
+            if (found_heavy_unhit_range)
+            {
+                // Add the heaviest point from this heaviest range to the net
+                // because  it makes the most sense to add teh point with the most point in the net out of the heaviest range
+                // this parrt of the implementation has been left open to do whatever in the paper
+                const auto &points_in_range = range_points(best_range_to_hit);
+                int point_to_add = *max_element(points_in_range.begin(), points_in_range.end(),
+                                                [&](int a, int b)
+                                                { return weights[a] < weights[b]; });
+
+                ws_.add_to_net(point_to_add);
+
+                // Mark all ranges hit by this new point
+                // all the ranges that the new point that we added are hit by it we need to mark them all
+                for (int i = 0; i < num_ranges; ++i)
+                {
+                    if (i % CANCEL_CHECK_INTERVAL == 0 && cancelled())
+                        return;
+                    if (!ws_.is_range_hit(i))
+                    {
+                        for (int p_idx : range_points(i))
+                        {
+                            HS_STAT(edges_scanned++);
+                            if (p_idx == point_to_add)
+                            {
+                                ws_.mark_range_hit(i);
+                                HS_STAT(range_hit_markings++);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    int verify_net(vector<int> &missed_points, const function<bool()> &cancelled) override
+    {
+        const int num_ranges = this->num_ranges();
+        for (int i = 0; i < num_ranges; ++i)
+        {
+            if (i % CANCEL_CHECK_INTERVAL == 0 && cancelled())
+                return -1;
+            const auto &range = range_points(i);
+            if (range.empty())
+                continue; // Nothing can hit an empty (e.g. removed) range
+
+            bool is_hit = false;
+            for (int point_idx : range)
+            {
+                HS_STAT(edges_scanned++);
+                if (ws_.in_net(point_idx))
+                {
+                    is_hit = true;
+                    break;
+                }
+            }
+            if (!is_hit)
+            {
+                missed_points.assign(range.begin(), range.end());
+                return i; // This range was missed.
+            }
+        }
+        return -1; // All ranges were hit.
+    }
+
+private:
+    int num_ranges() const { return graph_.num_ranges + (edits_ ? static_cast<int>(edits_->added.size()) : 0); }
+
+    const vector<int> &range_points(int i) const
+    {
+        static const vector<int> removed_range;
+        if (!edits_)
+            return graph_.ranges_to_points[i];
+        if (i >= graph_.num_ranges)
+            return edits_->added[i - graph_.num_ranges];
+        return !edits_->removed.empty() && edits_->removed[i] ? removed_range : graph_.ranges_to_points[i];
+    }
+
+    const Graph &graph_;
+    SolverWorkspace &ws_;
+    const GraphEdits *edits_;
+#ifdef HS_INSTRUMENT
+    SolverStats stats_;
+#endif
+};
+
+class HittingSetSolver
+{
+public:
+    HittingSetSolver(const Graph &graph) : owned_workspace_(new SolverWorkspace()),
+                                           ws_(*owned_workspace_),
+                                           owned_backend_(new InMemoryNetBackend(graph, ws_)),
+                                           backend_(*owned_backend_),
+                                           graph_(&graph) {}
+
+    // Reuses the caller's buffers; the workspace must outlive the solver.
+    HittingSetSolver(const Graph &graph, SolverWorkspace &workspace) : ws_(workspace),
+                                                                       owned_backend_(new InMemoryNetBackend(graph, ws_)),
+                                                                       backend_(*owned_backend_),
+                                                                       graph_(&graph) {}
+
+    // Runs the loop over another representation of the graph; the backend (and the
+    // workspace, which then only holds the weights) must outlive the solver.
+    // find_hitting_set_anytime needs one of the Graph constructors.
+    explicit HittingSetSolver(NetBackend &backend) : owned_workspace_(new SolverWorkspace()),
+                                                     ws_(*owned_workspace_),
+                                                     backend_(backend) {}
+    HittingSetSolver(NetBackend &backend, SolverWorkspace &workspace) : ws_(workspace), backend_(backend) {}
+
+    // Redirects the per-iteration trace (stdout by default).
+    void set_log(ostream &out) { log_ = &out; }
+
+    // Makes the doubling loop give up once the deadline passes. The backend polls
+    // the clock during its scans (every CANCEL_CHECK_INTERVAL ranges in memory).
+    void set_deadline(chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+
+    // c' of the round that produced the last hitting set returned.
+    int solved_c_prime() const { return solved_c_prime_; }
+
+    // True if the last solve gave up because the deadline passed.
+    bool timed_out() const { return cancelled_; }
+
+    // Calls save with the current state at the start of a doubling iteration
+    // whenever at least interval has passed since the last call.
+    void set_checkpointing(function<void(const SolverCheckpoint &)> save, chrono::steady_clock::duration interval)
+    {
+        save_checkpoint_ = move(save);
+        checkpoint_interval_ = interval;
+        last_checkpoint_ = chrono::steady_clock::now();
+    }
+
+    // The next solve continues from the checkpoint instead of starting at c' = 1.
+    void resume_from(SolverCheckpoint checkpoint) { resume_ = move(checkpoint); }
+
+#ifdef HS_INSTRUMENT
+    ~HittingSetSolver() { g_instrumentation.merge(stats_); }
+#endif
+
+
+    optional<unordered_set<int>> find_hitting_set()
+    {
+        num_points_ = backend_.num_points();
+        if (num_points_ == 0)
+            return unordered_set<int>();
+
+        ws_.prepare(num_points_, 0);
+        cancelled_ = false;
+        int first_c_prime = resume_ ? resume_->c_prime : 1;
+        last_failed_c_prime_ = first_c_prime / 2; // every earlier round failed
+
+        for (int c_prime = first_c_prime; c_prime <= num_points_; c_prime *= 2)
+        {
+            *log_ << "Attempting to find hitting set with optimal size c' = " << c_prime << " xxx\n";
+            if (find_hitting_set_for_c(c_prime))
+            {
+                *log_ << "\n>>> Success! Found a hitting set.\n";
+                solved_c_prime_ = c_prime;
+                return unordered_set<int>(backend_.net().begin(), backend_.net().end());
+            }
+            if (backend_.failed())
+                return nullopt;
+            if (cancelled_)
+            {
+                *log_ << "Deadline reached while trying c' = " << c_prime << ".\n";
+                return nullopt;
+            }
+            last_failed_c_prime_ = c_prime;
+            *log_ << "Failed to find a hitting set assuming c' = " << c_prime
+                 << ". Doubling c'...\n\n";
+        }
+        return nullopt; // Should not be reached if a hitting set exists.
+    }
+
+    // Runs the doubling loop under a deadline, starting from a greedy hitting set
+    // so that there is always an answer to return. By Lemma 3.4 every c' whose
+    // round ran to completion without success is below the optimum, which gives
+    // the lower bound.
+    AnytimeResult find_hitting_set_anytime(chrono::steady_clock::time_point deadline)
+    {
+        assert(graph_ && "anytime mode needs the graph in memory");
+        AnytimeResult best;
+        for (int i = 0; i < graph_->num_ranges && best.lower_bound == 0; ++i)
+            if (!graph_->ranges_to_points[i].empty())
+                best.lower_bound = 1;
+
+        // Kept in insertion order, so a resumed run rebuilds the identical set.
+        best_solution_ = resume_ && !resume_->best_solution.empty() ? resume_->best_solution : greedy_hitting_set();
+        best.hitting_set.emplace();
+        for (int p : best_solution_)
+            best.hitting_set->insert(p);
+        *log_ << "Greedy seed: hitting set of size " << best.hitting_set->size() << ".\n";
+
+        set_deadline(deadline);
+        auto result = find_hitting_set();
+        best.timed_out = cancelled_;
+        best.lower_bound = max(best.lower_bound, last_failed_c_prime_ + 1);
+        if (result && result->size() <= best.hitting_set->size())
+        {
+            best.hitting_set = move(result);
+            best.c_prime = solved_c_prime_;
+        }
+        best.lower_bound = min<int>(best.lower_bound, best.hitting_set->size());
+        return best;
+    }
+
+private:
+    bool deadline_passed()
+    {
+        if (!cancelled_ && chrono::steady_clock::now() >= deadline_)
+            cancelled_ = true;
+        return cancelled_;
+    }
+
+    void maybe_checkpoint(int c_prime, int iteration)
+    {
+        if (!save_checkpoint_ || chrono::steady_clock::now() - last_checkpoint_ < checkpoint_interval_)
+            return;
+        SolverCheckpoint checkpoint;
+        checkpoint.c_prime = c_prime;
+        checkpoint.iteration = iteration;
+        checkpoint.weight_exponents.resize(num_points_);
+        for (int p = 0; p < num_points_; ++p)
+            checkpoint.weight_exponents[p] = ilogb(ws_.weights[p]);
+        checkpoint.best_solution = best_solution_;
+        save_checkpoint_(checkpoint);
+        last_checkpoint_ = chrono::steady_clock::now();
+    }
+
+    // One pass over the ranges: every range not yet hit gets its highest-degree point.
+    vector<int> greedy_hitting_set()
+    {
+        vector<int> degree(graph_->num_points, 0);
+        for (const auto &range : graph_->ranges_to_points)
+            for (int p : range)
+                degree[p]++;
+        vector<char> chosen(graph_->num_points, 0);
+        vector<int> seed;
+        for (const auto &range : graph_->ranges_to_points)
+        {
+            if (range.empty() || any_of(range.begin(), range.end(), [&](int p)
+                                        { return chosen[p]; }))
+                continue;
+            int best = *max_element(range.begin(), range.end(), [&](int a, int b)
+                                    { return degree[a] < degree[b]; });
+            chosen[best] = 1;
+            seed.push_back(best);
+        }
+        return seed;
+    }
+
+    // On success the hitting set is left in the backend's net.
+    bool find_hitting_set_for_c(int c_prime)
+    {
+        HS_STAT(c_prime = c_prime);
+        HS_PHASE(PHASE_SOLVE_FOR_C);
+
+        // Initialize weights of all points to 1, or restore them from the checkpoint.
+        vector<double> &weights = ws_.weights;
+        int first_iteration = 0;
+        if (resume_ && resume_->c_prime == c_prime)
+        {
+            for (int p = 0; p < num_points_; ++p)
+                weights[p] = ldexp(1.0, resume_->weight_exponents[p]);
+            first_iteration = resume_->iteration;
+            resume_.reset();
+        }
+        else
+            fill(weights.begin(), weights.begin() + num_points_, 1.0);
+        backend_.weights_reset(weights);
+
+        // Lemma 3.4. If there is a hitting set of size c, the doubling process cannot iterate more than 4c log(n / c) times, and the total weight will not exceed n4 / c 3 .
+
+        double max_iterations_double = 4.0 * c_prime * log((double)num_points_ / c_prime);
+        
+        int max_iterations = static_cast<int>(ceil(max_iterations_double));
+
+        if (c_prime >= num_points_)
+            max_iterations = 1;
+        // Avoid log(x) where x<=1
+
+        *log_ << "Max iterations for c'=" << c_prime << " is " << max_iterations << endl;
+
+        for (int i = first_iteration; i < max_iterations; ++i)
+        {
+            if (deadline_passed() || backend_.failed())
+                return false;
+            maybe_checkpoint(c_prime, i);
+            *log_ << "Iteration " << i + 1 << ":" << endl;
+
+            // 1. Select a (1/2c')-net.
+
+            double epsilon = 1.0 / (2.0 * c_prime);
+            double total_weight = accumulate(weights.begin(), weights.begin() + num_points_, 0.0);
+            {
+                HS_PHASE(PHASE_NET);
+                HS_STAT(net_constructions++);
+                backend_.build_net(epsilon * total_weight, weights, cancel_check_);
+            }
+            if (cancelled_ || backend_.failed())
+                return false;
+
+            *log_ << "  - Computed a (1/" << 2 * c_prime << ")-net of size " << backend_.net().size() << ".";
+
+            // 2. Verify if the net is a hitting set.
+            int missed_idx;
+            {
+                HS_PHASE(PHASE_VERIFY);
+                missed_idx = backend_.verify_net(missed_points_, cancel_check_);
+            }
+            if (cancelled_ || backend_.failed())
+                return false;
+
+            if (missed_idx < 0)
+            {
+                // Verification succeeded: the net is a hitting set.
+                *log_ << " Net is a valid hitting set.\n";
+                return true;
+            }
+
+            // Verification failed: the net missed at least one range.
+            HS_STAT(nets_rejected[c_prime]++);
+            *log_ << " Net is not a hitting set. Missed range #" << missed_idx << ".\n";
+
+            // 3. Double the weights of all points in the missed range.
+            HS_PHASE(PHASE_REWEIGHT);
+            *log_ << "  - Doubling weights for points in missed range: { ";
+            for (int point_idx : missed_points_)
+            {
+                weights[point_idx] *= 2.0;
+                HS_STAT(weight_doublings++);
+                *log_ << point_idx << " ";
+            }
+            *log_ << "}\n";
+            backend_.weights_doubled(missed_points_);
+        }
+
+        return false;
+    }
+
+    unique_ptr<SolverWorkspace> owned_workspace_;
+    SolverWorkspace &ws_;
+    unique_ptr<InMemoryNetBackend> owned_backend_;
+    NetBackend &backend_;
+    const Graph *graph_ = nullptr; // null when solving through another backend
+    int num_points_ = 0;
+    vector<int> missed_points_;
+    ostream *log_ = &cout;
+    chrono::steady_clock::time_point deadline_ = chrono::steady_clock::time_point::max();
+    bool cancelled_ = false;
+    function<bool()> cancel_check_ = [this]()
+    { return deadline_passed(); };
+    int last_failed_c_prime_ = 0;
+    int solved_c_prime_ = 0;
+    function<void(const SolverCheckpoint &)> save_checkpoint_;
+    chrono::steady_clock::duration checkpoint_interval_{};
+    chrono::steady_clock::time_point last_checkpoint_;
+    optional<SolverCheckpoint> resume_;
+    vector<int> best_solution_;
+#ifdef HS_INSTRUMENT
+    SolverStats stats_;
+#endif
+};
+
+#endif // HITTING_SET_H
@@ -0,0 +1,159 @@
+#ifndef ILP_MODEL_H
+#define ILP_MODEL_H
+
+// The exact solver shared by solver and experiments: minimum hitting set as a 0/1
+// integer program, solved with GLPK.
+
+#include <csetjmp>
+#include <glpk.h>
+#include "hitting_set.h"
+
+enum IlpStatus
+{
+    ILP_SUCCESS,
+    ILP_TIMEOUT,
+    ILP_MEMORY_LIMIT,
+    ILP_ERROR
+};
+
+// Limits of one solve; 0 means none.
+struct IlpLimits
+{
+    int time_limit_ms = 0;
+    int memory_limit_mb = 0;
+};
+
+// GLPK reports a fatal error (a glp_mem_limit overrun among them) by calling the
+// error hook and then abort()ing the process. The hook installed by
+// solve_hitting_set_ilp jumps back into the solve instead, which then frees the
+// GLPK environment: that is the only way to recover, and it also releases the
+// half-built problem. Hooks, limits and the environment are per thread (GLPK keeps
+// its environment in thread-local storage), so this only affects the calling thread.
+struct IlpErrorTrap
+{
+    jmp_buf env;
+    string output; // what GLPK printed during the solve
+};
+
+inline int ilp_capture_output(void *info, const char *s)
+{
+    static_cast<IlpErrorTrap *>(info)->output += s;
+    return 1; // handled: GLPK prints nothing itself
+}
+
+inline void ilp_error_jump(void *info)
+{
+    longjmp(static_cast<IlpErrorTrap *>(info)->env, 1);
+}
+
+// One binary variable per point and one "at least one of these points" row per
+// non-empty range, minimising the number of points chosen. On success optimal_set
+// holds an optimal hitting set. If GLPK fails, its message goes to glpk_message
+// when given.
+inline IlpStatus solve_hitting_set_ilp(const Graph &graph, const IlpLimits &limits, unordered_set<int> &optimal_set,
+                                       string *glpk_message = nullptr)
+{
+    int n = graph.num_points;
+    int m = graph.num_ranges;
+    // GLPK requires 1-based indexing for arrays, so we add 1.
+    vector<int> ind(n + 1);
+    vector<double> val(n + 1);
+
+    // No local with a destructor may be declared below the setjmp: the jump would skip it.
+    IlpErrorTrap trap;
+    glp_term_hook(ilp_capture_output, &trap);
+    glp_error_hook(ilp_error_jump, &trap);
+    if (setjmp(trap.env))
+    {
+        glp_free_env();
+        if (glpk_message)
+            *glpk_message = trap.output;
+        string lower = trap.output;
+        transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        return lower.find("memory") != string::npos ? ILP_MEMORY_LIMIT : ILP_ERROR;
+    }
+    glp_mem_limit(limits.memory_limit_mb > 0 ? limits.memory_limit_mb : INT_MAX);
+
+    // 1. Create the ILP problem object
+    glp_prob *lp = glp_create_prob();
+    glp_set_obj_dir(lp, GLP_MIN); // We want to MINIMIZE
+
+    // 2. Add variables (columns) - one for each point
+    glp_add_cols(lp, n);
+    for (int i = 0; i < n; ++i)
+    {
+        glp_set_col_kind(lp, i + 1, GLP_BV); // Binary Variable (0 or 1)
+        glp_set_obj_coef(lp, i + 1, 1.0);    // Objective: Minimize sum of p_i
+    }
+
+    // 3. Add constraints (rows) - one for each range
+    glp_add_rows(lp, m);
+    for (int j = 0; j < m; ++j)
+    {
+        const auto &points_in_range = graph.ranges_to_points[j];
+        if (points_in_range.empty())
+            continue; // Nothing can hit an empty range: its row stays free
+
+        // This is the constraint: sum(p_i) >= 1
+        glp_set_row_bnds(lp, j + 1, GLP_LO, 1.0, 0.0);
+        int k = 0;
+        for (int point_idx : points_in_range)
+        {
+            k++;
+            ind[k] = point_idx + 1; // Point index (1-based)
+            val[k] = 1.0;           // Coefficient is 1.0
+        }
+        glp_set_mat_row(lp, j + 1, k, ind.data(), val.data());
+    }
+
+    // 4. Solve the problem
+    glp_iocp parm;
+    glp_init_iocp(&parm);
+    parm.presolve = GLP_ON;     // Use presolver
+    parm.msg_lev = GLP_MSG_OFF; // Turn off solver output
+    if (limits.time_limit_ms > 0)
+        parm.tm_lim = limits.time_limit_ms;
+
+    int err = glp_intopt(lp, &parm);
+    IlpStatus status = ILP_ERROR;
+    if (err == GLP_ETMLIM)
+        status = ILP_TIMEOUT;
+    else if (err == 0 && glp_mip_status(lp) == GLP_OPT)
+    {
+        // 5. Extract the solution
+        optimal_set.clear();
+        for (int i = 0; i < n; ++i)
+            if (glp_mip_col_val(lp, i + 1) > 0.5)
+                optimal_set.insert(i); // This point is in the optimal set
+        status = ILP_SUCCESS;
+    }
+
+    // 6. Clean up
+    glp_delete_prob(lp);
+    glp_error_hook(nullptr, nullptr);
+    glp_term_hook(nullptr, nullptr);
+    if (status == ILP_ERROR && glpk_message)
+        *glpk_message = trap.output;
+    return status;
+}
+
+/**
+ * Finds the true optimal hitting set using an
+ * Integer Linear Programming (ILP) solver (GLPK).
+ */
+inline optional<unordered_set<int>> findOptimalHittingSet_ILP(const Graph &graph)
+{
+    cout << "--- [ILP Solver] Solving for optimal solution... ---" << endl;
+    unordered_set<int> optimal_set;
+    string glpk_message;
+    if (solve_hitting_set_ilp(graph, IlpLimits(), optimal_set, &glpk_message) != ILP_SUCCESS)
+    {
+        cerr << glpk_message;
+        cout << "--- [ILP Solver] Error: Could not solve ILP. ---" << endl;
+        return nullopt;
+    }
+    cout << "--- [ILP Solver] Optimal solution size found: " << optimal_set.size() << " ---" << endl;
+    return optimal_set;
+}
+
+#endif // ILP_MODEL_H
@@ -1,224 +1,2320 @@
 #include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "hitting_set.h"
+#include "solution_cache.h"
 using namespace std;
 
-struct Graph
+// Keeps a hitting set valid while ranges and points are inserted into and deleted
+// from a live graph. Each update is repaired locally: a range left un-hit gets the
+// point of highest degree added, and solution points that only hit ranges already
+// hit by another solution point are pruned. The cost of an update depends on the
+// touched ranges and points only. Local repairs can drift away from what a fresh
+// solve would give, so once the solution grows more than drift_threshold above
+// its size right after the last full solve, the whole instance is solved again.
+class DynamicHittingSet
 {
-    int num_points;
-    int num_ranges;
-    // vector of point indices in range i.
-    // The index of the outer vector corresponds to a range's ID.
-    // The inner vector at that index stores the IDs of all the points contained within that specific range.
-    vector<vector<int>>
-        ranges_to_points;
+public:
+    // What changed in the solution since the previous take_delta().
+    struct Delta
+    {
+        vector<int> added;
+        vector<int> removed;
+        bool resolved = false; // a full re-solve happened
+    };
+
+    DynamicHittingSet(Graph &graph, double drift_threshold = 0.25) : graph_(graph),
+                                                                     drift_threshold_(drift_threshold)
+    {
+        // Duplicate (range, point) edges are kept once in the point-to-range index,
+        // so hit counts count distinct solution points.
+        points_to_ranges_.assign(graph_.num_points, {});
+        for (int r = 0; r < graph_.num_ranges; ++r)
+            for (int p : graph_.ranges_to_points[r])
+                if (points_to_ranges_[p].empty() || points_to_ranges_[p].back() != r)
+                    points_to_ranges_[p].push_back(r);
+        point_removed_.assign(graph_.num_points, 0);
+        solution_pos_.assign(graph_.num_points, -1);
+        pending_.assign(graph_.num_points, 0);
+        hit_count_.assign(graph_.num_ranges, 0);
+        range_removed_.assign(graph_.num_ranges, 0);
+    }
+
+    // Discards the current solution and solves the whole instance from scratch.
+    bool solve()
+    {
+        thread_local ostream null_log(nullptr);
+        HittingSetSolver solver(graph_, workspace_);
+        solver.set_log(null_log);
+        auto result = solver.find_hitting_set();
+        if (!result)
+            return false;
+
+        while (!solution_.empty())
+            remove_from_solution(solution_.back());
+        for (int p : *result)
+            add_to_solution(p);
+        for (int p : vector<int>(solution_))
+            try_prune(p);
+
+        resolved_ = true;
+        baseline_size_ = solution_.size();
+        return true;
+    }
+
+    // Adds a range containing the given points and returns its index.
+    int add_range(const vector<int> &points)
+    {
+        int r = graph_.add_range();
+        hit_count_.push_back(0);
+        range_removed_.push_back(0);
+        for (int p : points)
+        {
+            if (p < 0 || p >= graph_.num_points || point_removed_[p])
+                continue;
+            if (!points_to_ranges_[p].empty() && points_to_ranges_[p].back() == r)
+                continue; // listed twice
+            graph_.add_edge(r, p);
+            points_to_ranges_[p].push_back(r);
+            if (solution_pos_[p] >= 0)
+                hit_count_[r]++;
+        }
+        if (hit_count_[r] == 0)
+            cover(r);
+        check_drift();
+        return r;
+    }
+
+    void remove_range(int range_idx)
+    {
+        if (range_idx < 0 || range_idx >= graph_.num_ranges || range_removed_[range_idx])
+            return;
+        vector<int> &points = graph_.ranges_to_points[range_idx];
+        vector<int> candidates;
+        for (int p : points)
+        {
+            erase_value(points_to_ranges_[p], range_idx);
+            if (solution_pos_[p] >= 0)
+                candidates.push_back(p);
+        }
+        points.clear(); // an empty range is ignored by the solver
+        hit_count_[range_idx] = 0;
+        range_removed_[range_idx] = 1;
+        for (int p : candidates)
+            try_prune(p);
+        check_drift();
+    }
+
+    // Adds a point contained in the given ranges and returns its index.
+    int add_point(const vector<int> &ranges)
+    {
+        int p = graph_.add_point();
+        points_to_ranges_.emplace_back();
+        point_removed_.push_back(0);
+        solution_pos_.push_back(-1);
+        pending_.push_back(0);
+        for (int r : ranges)
+        {
+            if (r < 0 || r >= graph_.num_ranges || range_removed_[r])
+                continue;
+            if (find(points_to_ranges_[p].begin(), points_to_ranges_[p].end(), r) != points_to_ranges_[p].end())
+                continue; // listed twice
+            graph_.add_edge(r, p);
+            points_to_ranges_[p].push_back(r);
+        }
+        // Ranges only gain a point, so only one that used to be empty can be un-hit now.
+        for (int r : points_to_ranges_[p])
+            if (hit_count_[r] == 0)
+                cover(r);
+        check_drift();
+        return p;
+    }
+
+    // Removes a point from every range. Its index is retired, not reused.
+    void remove_point(int point_idx)
+    {
+        if (point_idx < 0 || point_idx >= graph_.num_points || point_removed_[point_idx])
+            return;
+        bool was_in_solution = solution_pos_[point_idx] >= 0;
+        if (was_in_solution)
+            remove_from_solution(point_idx);
+        for (int r : points_to_ranges_[point_idx])
+            erase_value(graph_.ranges_to_points[r], point_idx);
+        vector<int> ranges = move(points_to_ranges_[point_idx]);
+        points_to_ranges_[point_idx].clear();
+        point_removed_[point_idx] = 1;
+        if (was_in_solution)
+        {
+            for (int r : ranges)
+                if (hit_count_[r] == 0)
+                    cover(r);
+        }
+        check_drift();
+    }
+
+    const vector<int> &solution() const { return solution_; }
+
+    Delta take_delta()
+    {
+        Delta out;
+        for (int p : touched_)
+        {
+            if (pending_[p] > 0)
+                out.added.push_back(p);
+            else if (pending_[p] < 0)
+                out.removed.push_back(p);
+            pending_[p] = 0;
+        }
+        touched_.clear();
+        out.resolved = resolved_;
+        resolved_ = false;
+        return out;
+    }
+
+private:
+    // Removes every occurrence of value; order is not preserved.
+    static void erase_value(vector<int> &values, int value)
+    {
+        for (size_t k = 0; k < values.size();)
+        {
+            if (values[k] == value)
+            {
+                values[k] = values.back();
+                values.pop_back();
+            }
+            else
+                ++k;
+        }
+    }
+
+    void add_to_solution(int point_idx)
+    {
+        solution_pos_[point_idx] = static_cast<int>(solution_.size());
+        solution_.push_back(point_idx);
+        for (int r : points_to_ranges_[point_idx])
+            hit_count_[r]++;
+        record(point_idx, +1);
+    }
+
+    void remove_from_solution(int point_idx)
+    {
+        int pos = solution_pos_[point_idx];
+        solution_[pos] = solution_.back();
+        solution_pos_[solution_[pos]] = pos;
+        solution_.pop_back();
+        solution_pos_[point_idx] = -1;
+        for (int r : points_to_ranges_[point_idx])
+            hit_count_[r]--;
+        record(point_idx, -1);
+    }
+
+    // Accumulates the net change of point_idx since the last take_delta();
+    // an add followed by a remove (or vice versa) cancels out.
+    void record(int point_idx, int change)
+    {
+        if (pending_[point_idx] == 0)
+            touched_.push_back(point_idx);
+        pending_[point_idx] = static_cast<signed char>(pending_[point_idx] + change);
+    }
+
+    // Hits an un-hit, non-empty range with its point of highest degree, then prunes
+    // the solution points that share a range with it: only their ranges gained a hit.
+    void cover(int range_idx)
+    {
+        const auto &points = graph_.ranges_to_points[range_idx];
+        if (points.empty())
+            return;
+        int best = *max_element(points.begin(), points.end(), [&](int a, int b)
+                                { return points_to_ranges_[a].size() < points_to_ranges_[b].size(); });
+        add_to_solution(best);
+        for (int r : points_to_ranges_[best])
+            for (int p : graph_.ranges_to_points[r])
+                if (p != best)
+                    try_prune(p);
+    }
+
+    // Drops point_idx from the solution if every range it hits is also hit by another solution point.
+    void try_prune(int point_idx)
+    {
+        if (solution_pos_[point_idx] < 0)
+            return;
+        for (int r : points_to_ranges_[point_idx])
+            if (hit_count_[r] < 2)
+                return;
+        remove_from_solution(point_idx);
+    }
+
+    void check_drift()
+    {
+        if (solution_.size() > (1.0 + drift_threshold_) * baseline_size_ && solution_.size() > baseline_size_ + 1)
+            solve();
+    }
+
+    Graph &graph_;
+    double drift_threshold_;
+    SolverWorkspace workspace_;
+    vector<vector<int>> points_to_ranges_;
+    vector<char> point_removed_;
+    vector<char> range_removed_;
+    vector<int> solution_pos_; // index in solution_, or -1
+    vector<int> solution_;
+    vector<int> hit_count_; // solution points in each range
+    size_t baseline_size_ = 0;
+    vector<signed char> pending_; // +1 added / -1 removed since last take_delta()
+    vector<int> touched_;         // may hold duplicates whose pending_ went back to 0
+    bool resolved_ = false;
+};
+
+// Out-of-core mode. A graph is converted once into a range-major binary edge file:
+//   "HSEDGE01" | int64 n | int64 m | int64 e | uint64 offsets[m + 1] | int32 points[e]
+// where the points of range r are points[offsets[r] .. offsets[r + 1]). Solving then
+// streams the points array in large sequential blocks, so only the offsets, weights,
+// hit bits and the net (O(n + m)) stay resident however many edges there are.
+static const char EXTERNAL_MAGIC[8] = {'H', 'S', 'E', 'D', 'G', 'E', '0', '1'};
+static const uint64_t EXTERNAL_HEADER_BYTES = sizeof(EXTERNAL_MAGIC) + 3 * sizeof(int64_t);
+
+// Checks n, m and e against each other and the file size: both counts must fit in an
+// int, and the file must be exactly the header, the offsets and e points long.
+bool edge_file_header_valid(const int64_t header[3], uint64_t file_size)
+{
+    const int64_t n = header[0], m = header[1], e = header[2];
+    if (n < 0 || n > INT_MAX || m < 0 || m >= INT_MAX || e < 0)
+        return false;
+    const uint64_t data_offset = EXTERNAL_HEADER_BYTES + (static_cast<uint64_t>(m) + 1) * sizeof(uint64_t);
+    return file_size >= data_offset && (file_size - data_offset) % sizeof(int32_t) == 0 &&
+           (file_size - data_offset) / sizeof(int32_t) == static_cast<uint64_t>(e);
+}
+
+// The offsets must start at 0, never decrease and end at e.
+bool edge_file_offsets_valid(const uint64_t *offsets, int m, uint64_t num_edges)
+{
+    if (offsets[0] != 0 || offsets[m] != num_edges)
+        return false;
+    for (int r = 0; r < m; ++r)
+        if (offsets[r + 1] < offsets[r])
+            return false;
+    return true;
+}
+
+bool pread_full(int fd, void *buf, size_t len, uint64_t offset)
+{
+    char *out = static_cast<char *>(buf);
+    while (len > 0)
+    {
+        ssize_t got = pread(fd, out, len, static_cast<off_t>(offset));
+        if (got <= 0)
+        {
+            if (got < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+        out += got;
+        len -= static_cast<size_t>(got);
+        offset += static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+bool pwrite_full(int fd, const void *buf, size_t len, uint64_t offset)
+{
+    const char *in = static_cast<const char *>(buf);
+    while (len > 0)
+    {
+        ssize_t put = pwrite(fd, in, len, static_cast<off_t>(offset));
+        if (put <= 0)
+        {
+            if (put < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+        in += put;
+        len -= static_cast<size_t>(put);
+        offset += static_cast<uint64_t>(put);
+    }
+    return true;
+}
+
+// Reads the same text format as load_graph_from_file one edge at a time,
+// without holding the file in memory.
+class EdgeTextReader
+{
+public:
+    bool open(const string &path)
+    {
+        in_.open(path);
+        if (!in_)
+        {
+            cerr << "Could not open file: " << path << "\n";
+            return false;
+        }
+        vector<int> header;
+        while (header.empty() && read_line_ints(header))
+        {
+        }
+        if (header.size() < 2)
+        {
+            cerr << "First line must contain at least two integers: n m\n";
+            return false;
+        }
+        n = header[0];
+        m = header[1];
+        e = header.size() >= 3 ? header[2] : -1;
+        // Integers after "n m e" on the header line are already edge data.
+        for (size_t j = 3; j < header.size(); ++j)
+            pending_.push_back(header[j]);
+        return true;
+    }
+
+    // Yields the next (range, point) pair as written in the file.
+    bool next_edge(int &range_idx, int &point_idx)
+    {
+        if (e >= 0 && edges_read_ >= e)
+            return false;
+        while (pending_.size() - pending_pos_ < 2)
+        {
+            vector<int> ints;
+            if (!read_line_ints(ints))
+                return false;
+            pending_.erase(pending_.begin(), pending_.begin() + pending_pos_);
+            pending_pos_ = 0;
+            pending_.insert(pending_.end(), ints.begin(), ints.end());
+        }
+        range_idx = pending_[pending_pos_++];
+        point_idx = pending_[pending_pos_++];
+        edges_read_++;
+        return true;
+    }
+
+    int n = 0, m = 0;
+    long long e = -1;
+
+private:
+    bool read_line_ints(vector<int> &ints)
+    {
+        ints.clear();
+        if (!getline(in_, line_))
+            return false;
+        auto pos = line_.find('#');
+        if (pos != string::npos)
+            line_.resize(pos);
+        const char *p = line_.c_str();
+        char *end;
+        while (true)
+        {
+            long v = strtol(p, &end, 10);
+            if (end == p)
+                break;
+            ints.push_back(static_cast<int>(v));
+            p = end;
+        }
+        return true;
+    }
+
+    ifstream in_;
+    string line_;
+    vector<int> pending_;
+    size_t pending_pos_ = 0;
+    long long edges_read_ = 0;
+};
+
+// Converts a text graph into the binary edge file. Edges are placed range by range
+// in buckets of at most memory_bytes, re-reading the text once per bucket, so the
+// conversion itself also runs in bounded memory.
+bool build_external_edge_file(const string &text_path, const string &out_path, size_t memory_bytes)
+{
+    // Pass 1: degrees under both index bases, and whether the file is 1-based
+    // (same rule as load_graph_from_file).
+    EdgeTextReader reader;
+    if (!reader.open(text_path))
+        return false;
+    int n = reader.n, m = reader.m;
+    vector<uint64_t> degree0(m, 0), degree1(m, 0);
+    bool need_subtract = false;
+    int r, p;
+    while (reader.next_edge(r, p))
+    {
+        if ((r >= m || p >= n) && r - 1 >= 0 && r - 1 < m && p - 1 >= 0 && p - 1 < n)
+            need_subtract = true;
+        if (r >= 0 && r < m && p >= 0 && p < n)
+            degree0[r]++;
+        if (r - 1 >= 0 && r - 1 < m && p - 1 >= 0 && p - 1 < n)
+            degree1[r - 1]++;
+    }
+    const int shift = need_subtract ? 1 : 0;
+    vector<uint64_t> &degree = need_subtract ? degree1 : degree0;
+
+    vector<uint64_t> offsets(static_cast<size_t>(m) + 1, 0);
+    for (int i = 0; i < m; ++i)
+        offsets[i + 1] = offsets[i] + degree[i];
+    vector<uint64_t>().swap(degree0);
+    vector<uint64_t>().swap(degree1);
+    const uint64_t num_edges = offsets[m];
+
+    int fd = ::open(out_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0)
+    {
+        cerr << "Could not open output file: " << out_path << "\n";
+        return false;
+    }
+    int64_t header[3] = {n, m, static_cast<int64_t>(num_edges)};
+    const uint64_t data_offset = EXTERNAL_HEADER_BYTES + offsets.size() * sizeof(uint64_t);
+    bool ok = pwrite_full(fd, EXTERNAL_MAGIC, sizeof(EXTERNAL_MAGIC), 0) &&
+              pwrite_full(fd, header, sizeof(header), sizeof(EXTERNAL_MAGIC)) &&
+              pwrite_full(fd, offsets.data(), offsets.size() * sizeof(uint64_t), EXTERNAL_HEADER_BYTES);
+
+    // Pass 2..k: one re-read of the text per bucket of ranges [lo, hi).
+    const uint64_t bucket_edges = max<uint64_t>(1, memory_bytes / sizeof(int32_t));
+    vector<int32_t> bucket;
+    vector<uint64_t> cursor;
+    for (int lo = 0; ok && lo < m;)
+    {
+        int hi = lo + 1;
+        while (hi < m && offsets[hi + 1] - offsets[lo] <= bucket_edges)
+            ++hi;
+        bucket.assign(offsets[hi] - offsets[lo], 0);
+        cursor.assign(offsets.begin() + lo, offsets.begin() + hi);
+
+        EdgeTextReader pass;
+        pass.open(text_path);
+        while (pass.next_edge(r, p))
+        {
+            r -= shift;
+            p -= shift;
+            if (r >= lo && r < hi && p >= 0 && p < n)
+                bucket[cursor[r - lo]++ - offsets[lo]] = p;
+        }
+        ok = pwrite_full(fd, bucket.data(), bucket.size() * sizeof(int32_t), data_offset + offsets[lo] * sizeof(int32_t));
+        lo = hi;
+    }
+    ok = ok && fsync(fd) == 0;
+    close(fd);
+    if (!ok)
+    {
+        cerr << "Failed writing " << out_path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    cout << "Wrote edge file " << out_path << " (n=" << n << ", m=" << m << ", e=" << num_edges << ")\n";
+    return true;
+}
+
+// An opened binary edge file; only the header and offsets are read into memory.
+struct ExternalEdgeFile
+{
+    int fd = -1;
+    int num_points = 0;
+    int num_ranges = 0;
+    uint64_t num_edges = 0;
+    uint64_t data_offset = 0;
+    vector<uint64_t> offsets;
+
+    ExternalEdgeFile() = default;
+    ExternalEdgeFile(const ExternalEdgeFile &) = delete;
+    ExternalEdgeFile &operator=(const ExternalEdgeFile &) = delete;
+    ~ExternalEdgeFile()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool open(const string &path)
+    {
+        fd = ::open(path.c_str(), O_RDONLY);
+        char magic[sizeof(EXTERNAL_MAGIC)];
+        int64_t header[3];
+        if (fd < 0 || !pread_full(fd, magic, sizeof(magic), 0) || memcmp(magic, EXTERNAL_MAGIC, sizeof(magic)) != 0 ||
+            !pread_full(fd, header, sizeof(header), sizeof(magic)))
+        {
+            cerr << "Not a hitting set edge file: " << path << "\n";
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0 || !edge_file_header_valid(header, static_cast<uint64_t>(st.st_size)))
+        {
+            cerr << "Corrupt edge file: " << path << "\n";
+            return false;
+        }
+        num_points = static_cast<int>(header[0]);
+        num_ranges = static_cast<int>(header[1]);
+        num_edges = static_cast<uint64_t>(header[2]);
+        offsets.resize(static_cast<size_t>(num_ranges) + 1);
+        data_offset = EXTERNAL_HEADER_BYTES + offsets.size() * sizeof(uint64_t);
+        if (!pread_full(fd, offsets.data(), offsets.size() * sizeof(uint64_t), EXTERNAL_HEADER_BYTES) ||
+            !edge_file_offsets_valid(offsets.data(), num_ranges, num_edges))
+        {
+            cerr << "Corrupt edge file: " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+};
+
+// Streams the points array of an ExternalEdgeFile front to back, range by range.
+// A prefetch thread pread()s block k+1 into one buffer while the caller works on
+// block k in the other. Ranges that straddle a block boundary are stitched together
+// in a spill buffer, so callbacks always see a range's points contiguously.
+class RangeStreamer
+{
+public:
+    RangeStreamer(const ExternalEdgeFile &file, size_t block_bytes) : file_(file),
+                                                                      block_edges_(max<size_t>(1, min<uint64_t>(block_bytes / sizeof(int32_t), file.num_edges)))
+    {
+        for (auto &b : buffers_)
+            b.data.resize(block_edges_);
+        prefetcher_ = thread([this]()
+                             { prefetch_loop(); });
+    }
+
+    ~RangeStreamer()
+    {
+        {
+            lock_guard<mutex> lock(mu_);
+            shutdown_ = true;
+        }
+        cv_.notify_all();
+        prefetcher_.join();
+    }
+
+    // Calls fn(range_idx, points, count) for every range in order; fn returns false to stop early.
+    template <class Fn>
+    bool for_each_range(Fn fn)
+    {
+        start_scan();
+        bool completed = true;
+        uint64_t block_start = 0;
+        int range_idx = 0;
+        const auto &offsets = file_.offsets;
+        for (int k = 0; completed && block_start < file_.num_edges; ++k)
+        {
+            Buffer &buf = wait_full(k);
+            if (buf.failed)
+            {
+                cerr << "Read error in edge file\n";
+                release(buf);
+                completed = false;
+                break;
+            }
+            uint64_t block_end = block_start + buf.count;
+            // Finish a range started in an earlier block, then every range that ends in this one.
+            while (range_idx < file_.num_ranges && offsets[range_idx + 1] <= block_end)
+            {
+                uint64_t begin = offsets[range_idx], end = offsets[range_idx + 1];
+                const int32_t *points;
+                if (begin >= block_start)
+                    points = buf.data.data() + (begin - block_start);
+                else
+                {
+                    spill_.insert(spill_.end(), buf.data.begin(), buf.data.begin() + (end - block_start));
+                    points = spill_.data();
+                }
+                bool keep_going = fn(range_idx, points, static_cast<size_t>(end - begin));
+                spill_.clear();
+                ++range_idx;
+                if (!keep_going)
+                {
+                    completed = false;
+                    break;
+                }
+            }
+            // Carry the head of a range that continues into the next block.
+            if (completed && range_idx < file_.num_ranges && offsets[range_idx] < block_end)
+            {
+                uint64_t from = max(offsets[range_idx], block_start);
+                spill_.insert(spill_.end(), buf.data.begin() + (from - block_start), buf.data.begin() + buf.count);
+            }
+            release(buf);
+            block_start = block_end;
+        }
+        // Empty ranges after the last edge.
+        for (; completed && range_idx < file_.num_ranges; ++range_idx)
+            completed = fn(range_idx, spill_.data(), 0);
+        finish_scan();
+        spill_.clear();
+        return completed;
+    }
+
+private:
+    struct Buffer
+    {
+        vector<int32_t> data;
+        size_t count = 0;
+        long long block = -1; // block held, -1 when free
+        bool ready = false;   // pread finished
+        bool failed = false;
+    };
+
+    void start_scan()
+    {
+        lock_guard<mutex> lock(mu_);
+        next_block_ = 0;
+        stop_scan_ = false;
+        for (auto &b : buffers_)
+        {
+            b.block = -1;
+            b.ready = false;
+        }
+        scanning_ = true;
+        cv_.notify_all();
+    }
+
+    // Stops the prefetcher (it may be ahead of an early-terminated scan) and waits for it to go idle.
+    void finish_scan()
+    {
+        unique_lock<mutex> lock(mu_);
+        stop_scan_ = true;
+        cv_.notify_all();
+        cv_.wait(lock, [&]()
+                 { return !prefetching_; });
+        scanning_ = false;
+    }
+
+    Buffer &wait_full(long long block)
+    {
+        unique_lock<mutex> lock(mu_);
+        Buffer *found = nullptr;
+        cv_.wait(lock, [&]()
+                 {
+                     for (auto &b : buffers_)
+                         if (b.block == block && b.ready)
+                             found = &b;
+                     return found != nullptr; });
+        return *found;
+    }
+
+    void release(Buffer &buf)
+    {
+        lock_guard<mutex> lock(mu_);
+        buf.block = -1;
+        buf.ready = false;
+        cv_.notify_all();
+    }
+
+    void prefetch_loop()
+    {
+        const uint64_t num_blocks = (file_.num_edges + block_edges_ - 1) / block_edges_;
+        unique_lock<mutex> lock(mu_);
+        while (true)
+        {
+            Buffer *slot = nullptr;
+            cv_.wait(lock, [&]()
+                     {
+                         if (shutdown_)
+                             return true;
+                         if (!scanning_ || stop_scan_ || next_block_ >= num_blocks)
+                             return false;
+                         for (auto &b : buffers_)
+                             if (b.block < 0)
+                                 slot = &b;
+                         return slot != nullptr; });
+            if (shutdown_)
+                return;
+
+            long long block = next_block_++;
+            slot->block = block;
+            slot->ready = false;
+            prefetching_ = true;
+            lock.unlock();
+
+            uint64_t first = static_cast<uint64_t>(block) * block_edges_;
+            slot->count = static_cast<size_t>(min<uint64_t>(block_edges_, file_.num_edges - first));
+            slot->failed = !pread_full(file_.fd, slot->data.data(), slot->count * sizeof(int32_t),
+                                       file_.data_offset + first * sizeof(int32_t));
+
+            lock.lock();
+            slot->ready = true;
+            prefetching_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    const ExternalEdgeFile &file_;
+    size_t block_edges_;
+    Buffer buffers_[2];
+    vector<int32_t> spill_;
+    thread prefetcher_;
+    mutex mu_;
+    condition_variable cv_;
+    bool shutdown_ = false;
+    bool scanning_ = false;
+    bool stop_scan_ = false;
+    bool prefetching_ = false;
+    uint64_t next_block_ = 0;
+};
+
+// NetBackend over an ExternalEdgeFile. The net rule is the in-memory one, so both
+// produce the same hitting set. Each pass over the ranges is one sequential scan of
+// the file: picking the next heaviest un-hit range is fused with marking the ranges
+// hit by the point picked before it, so building a net of size k costs k + 1 scans
+// plus one for verification. Only the per-point and per-range scratch arrays of the
+// workspace are held in memory.
+class ExternalNetBackend : public NetBackend
+{
+public:
+    ExternalNetBackend(const ExternalEdgeFile &file, size_t block_bytes, SolverWorkspace &workspace) : file_(file),
+                                                                                                      streamer_(file, block_bytes),
+                                                                                                      ws_(workspace) {}
+
+#ifdef HS_INSTRUMENT
+    ~ExternalNetBackend() { g_instrumentation.merge(stats_); }
+#endif
+
+    int num_points() const override { return file_.num_points; }
+    const vector<int> &net() const override { return ws_.net; }
+    bool failed() const override { return failed_; }
+
+    void build_net(double weight_threshold, const vector<double> &weights, const function<bool()> &cancelled) override
+    {
+        ws_.prepare(file_.num_points, file_.num_ranges);
+        ws_.begin_net();
+        int last_added = -1;
+
+        while (true)
+        {
+            int best_range_to_hit = -1;
+            int best_point = -1;
+            double max_weight = -1.0;
+
+            bool stopped = false;
+            bool completed = streamer_.for_each_range([&](int range_idx, const int32_t *points, size_t count)
+                                                      {
+                                                          if (range_idx % CANCEL_CHECK_INTERVAL == 0 && cancelled())
+                                                          {
+                                                              stopped = true;
+                                                              return false;
+                                                          }
+                                                          if (ws_.is_range_hit(range_idx))
+                                                              return true;
+                                                          double current_range_weight = 0.0;
+                                                          int heaviest = -1;
+                                                          for (size_t k = 0; k < count; ++k)
+                                                          {
+                                                              int p = points[k];
+                                                              HS_STAT(edges_scanned++);
+                                                              if (p == last_added)
+                                                              {
+                                                                  ws_.mark_range_hit(range_idx);
+                                                                  HS_STAT(range_hit_markings++);
+                                                                  return true;
+                                                              }
+                                                              current_range_weight += weights[p];
+                                                              if (heaviest < 0 || weights[heaviest] < weights[p])
+                                                                  heaviest = p;
+                                                          }
+                                                          if (current_range_weight > weight_threshold && current_range_weight > max_weight)
+                                                          {
+                                                              max_weight = current_range_weight;
+                                                              best_range_to_hit = range_idx;
+                                                              best_point = heaviest;
+                                                          }
+                                                          return true; });
+            if (!completed)
+            {
+                failed_ = !stopped;
+                return;
+            }
+
+            if (best_range_to_hit < 0)
+                break;
+            ws_.add_to_net(best_point);
+            last_added = best_point;
+        }
+    }
+
+    int verify_net(vector<int> &missed_points, const function<bool()> &cancelled) override
+    {
+        int missed = -1;
+        bool stopped = false;
+        bool completed = streamer_.for_each_range([&](int range_idx, const int32_t *points, size_t count)
+                                                  {
+                                                      if (range_idx % CANCEL_CHECK_INTERVAL == 0 && cancelled())
+                                                      {
+                                                          stopped = true;
+                                                          return false;
+                                                      }
+                                                      if (count == 0)
+                                                          return true;
+                                                      for (size_t k = 0; k < count; ++k)
+                                                      {
+                                                          HS_STAT(edges_scanned++);
+                                                          if (ws_.in_net(points[k]))
+                                                              return true;
+                                                      }
+                                                      missed = range_idx;
+                                                      missed_points.assign(points, points + count);
+                                                      return false; });
+        if (!completed && missed < 0 && !stopped)
+            failed_ = true;
+        return missed;
+    }
+
+private:
+    const ExternalEdgeFile &file_;
+    RangeStreamer streamer_;
+    SolverWorkspace &ws_;
+    bool failed_ = false;
+#ifdef HS_INSTRUMENT
+    SolverStats stats_;
+#endif
+};
+
+void print_hitting_set(const optional<unordered_set<int>> &result)
+{
+    if (result)
+    {
+        cout << "\nFinal Hitting Set (point indices): { ";
+        for (int point_idx : *result)
+        {
+            cout << point_idx << " ";
+        }
+        cout << "}\n";
+        cout << "Size of hitting set: " << result->size() << endl;
+    }
+    else
+    {
+        cout << "Could not find a hitting set." << endl;
+    }
+}
+
+// Checkpoint file of --checkpoint, replaced atomically (write aside, fsync, rename)
+// on every save:
+//   "HSCKPT01", uint32 mode (0 plain, 1 deadline), uint64 instance_hash, int32 n,
+//   int32 c', int32 iteration, uint32 k, int32 best_solution[k], int32 weight_exponents[n]
+static const char CHECKPOINT_MAGIC[8] = {'H', 'S', 'C', 'K', 'P', 'T', '0', '1'};
+
+bool save_checkpoint(const string &path, uint32_t mode, uint64_t hash, const SolverCheckpoint &checkpoint)
+{
+    string data;
+    auto put = [&](const void *in, size_t len)
+    { data.append(static_cast<const char *>(in), len); };
+    int32_t n = checkpoint.weight_exponents.size();
+    uint32_t k = checkpoint.best_solution.size();
+    put(CHECKPOINT_MAGIC, 8);
+    put(&mode, 4);
+    put(&hash, 8);
+    put(&n, 4);
+    put(&checkpoint.c_prime, 4);
+    put(&checkpoint.iteration, 4);
+    put(&k, 4);
+    put(checkpoint.best_solution.data(), (size_t)k * 4);
+    put(checkpoint.weight_exponents.data(), (size_t)n * 4);
+
+    string tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        cerr << "Could not write checkpoint: " << tmp_path << "\n";
+        return false;
+    }
+    bool ok = pwrite_full(fd, data.data(), data.size(), 0) && fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        cerr << "Could not write checkpoint: " << path << "\n";
+        unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Returns false if there is no usable checkpoint for this instance and mode.
+bool load_checkpoint(const string &path, uint32_t mode, uint64_t hash, int num_points, SolverCheckpoint &checkpoint)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    string data;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok)
+    {
+        data.resize(st.st_size);
+        ok = pread_full(fd, &data[0], data.size(), 0);
+    }
+    ::close(fd);
+
+    size_t pos = 0;
+    auto get = [&](void *out, size_t len)
+    {
+        if (pos + len > data.size())
+            return false;
+        memcpy(out, data.data() + pos, len);
+        pos += len;
+        return true;
+    };
+    char magic[8];
+    uint32_t stored_mode = 0, k = 0;
+    uint64_t stored_hash = 0;
+    int32_t n = 0;
+    ok = ok && get(magic, 8) && memcmp(magic, CHECKPOINT_MAGIC, 8) == 0 &&
+         get(&stored_mode, 4) && get(&stored_hash, 8) && get(&n, 4) &&
+         get(&checkpoint.c_prime, 4) && get(&checkpoint.iteration, 4) && get(&k, 4) &&
+         (uint64_t)k * 4 + (uint64_t)n * 4 == data.size() - pos;
+    if (!ok || stored_mode != mode || stored_hash != hash || n != num_points ||
+        checkpoint.c_prime < 1 || checkpoint.c_prime > num_points || checkpoint.iteration < 0 ||
+        (checkpoint.c_prime & (checkpoint.c_prime - 1)) != 0)
+    {
+        cerr << "Ignoring checkpoint " << path << ": it does not match this instance and mode\n";
+        return false;
+    }
+    checkpoint.best_solution.resize(k);
+    checkpoint.weight_exponents.resize(n);
+    get(checkpoint.best_solution.data(), (size_t)k * 4);
+    get(checkpoint.weight_exponents.data(), (size_t)n * 4);
+    for (int p : checkpoint.best_solution)
+        if (p < 0 || p >= num_points)
+            return false;
+    return true;
+}
+
+// --checkpoint / --checkpoint-every / --resume, accepted by every mode that runs
+// HittingSetSolver (the default, --external and --coordinator).
+struct CheckpointOptions
+{
+    string path;
+    double seconds = 60.0;
+    bool resume = false;
+
+    // Consumes one option and its value; false if it is not a checkpoint option.
+    bool parse(const string &option, const char *value)
+    {
+        if (option == "--checkpoint")
+            path = value;
+        else if (option == "--checkpoint-every")
+            seconds = atof(value);
+        else if (option == "--resume")
+        {
+            path = value;
+            resume = true;
+        }
+        else
+            return false;
+        return true;
+    }
+};
+
+// Continues from the checkpoint file if asked to and it matches, then saves the
+// solver state there periodically.
+void setup_checkpointing(HittingSetSolver &solver, const CheckpointOptions &options, uint32_t mode, uint64_t hash, int num_points)
+{
+    SolverCheckpoint checkpoint;
+    if (options.resume && load_checkpoint(options.path, mode, hash, num_points, checkpoint))
+    {
+        cout << "Resuming from checkpoint at c' = " << checkpoint.c_prime << ", iteration "
+             << checkpoint.iteration + 1 << ".\n"
+             << endl;
+        solver.resume_from(move(checkpoint));
+    }
+    string path = options.path;
+    solver.set_checkpointing([=](const SolverCheckpoint &state)
+                             { save_checkpoint(path, mode, hash, state); },
+                             chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(options.seconds)));
+}
+
+// instance_hash of the graph an edge file was built from, in one scan of the file.
+bool edge_file_hash(const ExternalEdgeFile &file, size_t block_bytes, uint64_t &hash)
+{
+    InstanceHasher hasher(file.num_points, file.num_ranges);
+    RangeStreamer streamer(file, block_bytes);
+    bool ok = streamer.for_each_range([&](int, const int32_t *points, size_t count)
+                                      {
+                                          hasher.add_range(points, points + count);
+                                          return true; });
+    hash = hasher.value();
+    return ok;
+}
+
+int run_external(const string &edge_path, size_t block_bytes, const CheckpointOptions &checkpoint)
+{
+    ExternalEdgeFile file;
+    if (!file.open(edge_path))
+        return 1;
+    cout << "Finding hitting set for the graph...\n"
+         << endl;
+    SolverWorkspace workspace;
+    ExternalNetBackend backend(file, block_bytes, workspace);
+    HittingSetSolver solver(backend, workspace);
+    if (!checkpoint.path.empty())
+    {
+        uint64_t hash = 0;
+        if (!edge_file_hash(file, block_bytes, hash))
+            return 1;
+        setup_checkpointing(solver, checkpoint, 0, hash, file.num_points);
+    }
+    auto result = solver.find_hitting_set();
+    if (!checkpoint.path.empty() && !backend.failed())
+        unlink(checkpoint.path.c_str());
+    print_hitting_set(result);
+    return result ? 0 : 1;
+}
+
+// Online hitting set for ranges that arrive one at a time. The solution only ever
+// grows, so it is valid for every range seen so far. A range that arrives un-hit
+// doubles the weight of each of its points, like the reweighting step of the
+// offline solver, and its heaviest point joins the solution. Points that keep
+// showing up in missed ranges get heavy, and they are the ones likely to hit later
+// ranges as well. Weights are kept as doubling counts (weight = 2^count), so they
+// never overflow. Ranges are not stored: memory is O(largest point id seen), and
+// ids above max_point are ignored so that one stray id cannot blow it up.
+class OnlineHittingSet
+{
+public:
+    explicit OnlineHittingSet(int max_point) : max_point_(min(max_point, INT_MAX - 1)) {}
+
+    bool accepts(long long point_idx) const { return point_idx >= 0 && point_idx <= max_point_; }
+
+    // Processes one range. Returns the point added to hit it, or -1 if it was
+    // already hit (or has no accepted point).
+    int add_range(const vector<int> &points)
+    {
+        int heaviest = -1;
+        for (int p : points)
+        {
+            if (!accepts(p))
+                continue;
+            if (p >= static_cast<int>(doublings_.size()))
+            {
+                doublings_.resize(p + 1, 0);
+                in_solution_.resize(p + 1, 0);
+            }
+            if (in_solution_[p])
+                return -1;
+        }
+        for (int p : points)
+        {
+            if (!accepts(p))
+                continue;
+            doublings_[p]++;
+            if (heaviest < 0 || doublings_[heaviest] < doublings_[p])
+                heaviest = p;
+        }
+        if (heaviest >= 0)
+        {
+            in_solution_[heaviest] = 1;
+            solution_size_++;
+        }
+        return heaviest;
+    }
+
+    size_t size() const { return solution_size_; }
+
+private:
+    int max_point_;
+    vector<uint32_t> doublings_;
+    vector<char> in_solution_;
+    size_t solution_size_ = 0;
+};
+
+// Reads one range per line (point indices separated by spaces, '#' comments) from
+// `in` until end of input and writes "+<point>" as soon as a point joins the solution.
+// Ids outside 0..max_point are dropped with a warning.
+int run_stream(istream &in, int max_point)
+{
+    OnlineHittingSet online(max_point);
+    string line;
+    vector<int> points;
+    long long ranges_seen = 0, line_no = 0;
+    while (getline(in, line))
+    {
+        line_no++;
+        auto pos = line.find('#');
+        if (pos != string::npos)
+            line.resize(pos);
+        points.clear();
+        const char *p = line.c_str();
+        char *end;
+        bool any_id = false, dropped = false;
+        while (true)
+        {
+            errno = 0;
+            long long v = strtoll(p, &end, 10);
+            if (end == p)
+                break;
+            any_id = true;
+            if (errno == ERANGE || !online.accepts(v))
+                dropped = true;
+            else
+                points.push_back(static_cast<int>(v));
+            p = end;
+        }
+        if (dropped)
+            cerr << "Warning: line " << line_no << ": ignoring point ids outside 0.." << max_point << "\n";
+        if (!any_id)
+            continue;
+        ranges_seen++;
+        int added = online.add_range(points);
+        if (added >= 0)
+            cout << "+" << added << endl;
+    }
+    cout << "Ranges processed: " << ranges_seen << "\n";
+    cout << "Size of hitting set: " << online.size() << endl;
+    return 0;
+}
+
+// Sharded mode: a coordinator process drives K worker processes, each owning a
+// contiguous slice of the ranges of an edge file built with --build-external.
+// Workers mmap the file, so on one machine they all share one page-cache copy of
+// the graph. Every worker keeps its own replica of the point weights and the net.
+// Each net step, workers report the heaviest un-hit range in their slice and the
+// coordinator picks the global winner. Each verification, workers report their
+// first missed range and the coordinator keeps the lowest. Weight doublings are
+// broadcast as point lists. Ties go to the lowest range index, as in the serial
+// loop, so the result equals HittingSetSolver's. Messages are length-prefixed
+// frames over stream sockets (Unix domain sockets here); nothing else in the
+// protocol assumes the workers are local.
+enum ShardMessage : uint32_t
+{
+    SHARD_ASSIGN = 1,    // coordinator -> worker: int lo, int hi
+    SHARD_RESET_WEIGHTS, // all weights back to 1
+    SHARD_BEGIN_NET,     // empty the net
+    SHARD_NEXT,          // int last_added, double threshold -> SHARD_CANDIDATE
+    SHARD_VERIFY,        // -> SHARD_MISSED
+    SHARD_DOUBLE,        // int points[]: double these weights
+    SHARD_SHUTDOWN,
+    SHARD_CANDIDATE,     // worker -> coordinator: double weight, int range, int point (range -1: none)
+    SHARD_MISSED,        // int range (-1: none), int points[]
+    SHARD_SET_WEIGHTS    // double weights[]: every point's weight (resuming from a checkpoint)
+};
+
+struct ShardFrame
+{
+    uint32_t type = 0;
+    vector<char> payload;
+
+    template <class T>
+    void put(const T &value)
+    {
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        payload.insert(payload.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <class T>
+    T get(size_t &pos) const
+    {
+        T value{};
+        if (pos + sizeof(T) <= payload.size())
+            memcpy(&value, payload.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+};
+
+bool send_frame(int fd, const ShardFrame &frame)
+{
+    uint32_t header[2] = {frame.type, static_cast<uint32_t>(frame.payload.size())};
+    string data(reinterpret_cast<const char *>(header), sizeof(header));
+    data.append(frame.payload.begin(), frame.payload.end());
+    size_t off = 0;
+    while (off < data.size())
+    {
+        ssize_t w = write(fd, data.data() + off, data.size() - off);
+        if (w <= 0)
+        {
+            if (w < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+        off += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+bool read_exact(int fd, void *buf, size_t len)
+{
+    char *out = static_cast<char *>(buf);
+    while (len > 0)
+    {
+        ssize_t got = read(fd, out, len);
+        if (got <= 0)
+        {
+            if (got < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+        out += got;
+        len -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+bool recv_frame(int fd, ShardFrame &frame)
+{
+    uint32_t header[2];
+    if (!read_exact(fd, header, sizeof(header)))
+        return false;
+    frame.type = header[0];
+    frame.payload.resize(header[1]);
+    return read_exact(fd, frame.payload.data(), header[1]);
+}
+
+int run_shard_worker(const string &socket_path, const string &edge_path)
+{
+#ifdef HS_INSTRUMENT
+    g_instrumentation.enabled = false; // the coordinator reports the solve
+#endif
+    int fd = ::open(edge_path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0 || static_cast<uint64_t>(st.st_size) < EXTERNAL_HEADER_BYTES)
+    {
+        cerr << "Could not open edge file: " << edge_path << "\n";
+        return 1;
+    }
+    void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED || memcmp(mapped, EXTERNAL_MAGIC, sizeof(EXTERNAL_MAGIC)) != 0)
+    {
+        cerr << "Not a hitting set edge file: " << edge_path << "\n";
+        return 1;
+    }
+    const char *base = static_cast<const char *>(mapped);
+    int64_t header[3];
+    memcpy(header, base + sizeof(EXTERNAL_MAGIC), sizeof(header));
+    const int n = static_cast<int>(header[0]), m = static_cast<int>(header[1]);
+    const uint64_t *offsets = reinterpret_cast<const uint64_t *>(base + EXTERNAL_HEADER_BYTES);
+    if (!edge_file_header_valid(header, static_cast<uint64_t>(st.st_size)) ||
+        !edge_file_offsets_valid(offsets, m, static_cast<uint64_t>(header[2])))
+    {
+        cerr << "Corrupt edge file: " << edge_path << "\n";
+        munmap(mapped, st.st_size);
+        return 1;
+    }
+    const int32_t *edges = reinterpret_cast<const int32_t *>(base + EXTERNAL_HEADER_BYTES + (m + 1) * sizeof(uint64_t));
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    if (sock < 0 || connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        cerr << "Could not connect to coordinator at " << socket_path << "\n";
+        return 1;
+    }
+
+    SolverWorkspace ws;
+    ws.prepare(n, m);
+    vector<double> &weights = ws.weights;
+    fill(weights.begin(), weights.begin() + n, 1.0);
+    int lo = 0, hi = 0;
+
+    ShardFrame in, out;
+    while (recv_frame(sock, in))
+    {
+        size_t pos = 0;
+        out = ShardFrame();
+        switch (in.type)
+        {
+        case SHARD_ASSIGN:
+            lo = in.get<int>(pos);
+            hi = in.get<int>(pos);
+            break;
+        case SHARD_RESET_WEIGHTS:
+            fill(weights.begin(), weights.begin() + n, 1.0);
+            break;
+        case SHARD_BEGIN_NET:
+            ws.begin_net();
+            break;
+        case SHARD_NEXT:
+        {
+            int last_added = in.get<int>(pos);
+            double threshold = in.get<double>(pos);
+            if (last_added >= 0)
+                ws.add_to_net(last_added);
+            double max_weight = -1.0;
+            int best_range = -1, best_point = -1;
+            for (int r = lo; r < hi; ++r)
+            {
+                if (ws.is_range_hit(r))
+                    continue;
+                double range_weight = 0.0;
+                int heaviest = -1;
+                bool hit_now = false;
+                for (uint64_t k = offsets[r]; k < offsets[r + 1]; ++k)
+                {
+                    int p = edges[k];
+                    if (p == last_added)
+                    {
+                        hit_now = true;
+                        break;
+                    }
+                    range_weight += weights[p];
+                    if (heaviest < 0 || weights[heaviest] < weights[p])
+                        heaviest = p;
+                }
+                if (hit_now)
+                    ws.mark_range_hit(r);
+                else if (range_weight > threshold && range_weight > max_weight)
+                {
+                    max_weight = range_weight;
+                    best_range = r;
+                    best_point = heaviest;
+                }
+            }
+            out.type = SHARD_CANDIDATE;
+            out.put(max_weight);
+            out.put(best_range);
+            out.put(best_point);
+            break;
+        }
+        case SHARD_VERIFY:
+        {
+            out.type = SHARD_MISSED;
+            int missed = -1;
+            for (int r = lo; r < hi && missed < 0; ++r)
+            {
+                if (offsets[r] == offsets[r + 1])
+                    continue;
+                bool hit = false;
+                for (uint64_t k = offsets[r]; k < offsets[r + 1] && !hit; ++k)
+                    hit = ws.in_net(edges[k]);
+                if (!hit)
+                    missed = r;
+            }
+            out.put(missed);
+            if (missed >= 0)
+                for (uint64_t k = offsets[missed]; k < offsets[missed + 1]; ++k)
+                    out.put(static_cast<int>(edges[k]));
+            break;
+        }
+        case SHARD_DOUBLE:
+            while (pos < in.payload.size())
+                weights[in.get<int>(pos)] *= 2.0;
+            break;
+        case SHARD_SET_WEIGHTS:
+            for (int p = 0; p < n && pos < in.payload.size(); ++p)
+                weights[p] = in.get<double>(pos);
+            break;
+        case SHARD_SHUTDOWN:
+            close(sock);
+            munmap(mapped, st.st_size);
+            return 0;
+        }
+        if (out.type != 0 && !send_frame(sock, out))
+            break;
+    }
+    close(sock);
+    munmap(mapped, st.st_size);
+    return 1;
+}
+
+// The coordinator side: a NetBackend that fans the per-range work out to the
+// connected workers and keeps their weight replicas in step with the solver's.
+class ShardedNetBackend : public NetBackend
+{
+public:
+    ShardedNetBackend(int num_points, const vector<int> &worker_fds) : num_points_(num_points),
+                                                                       worker_fds_(worker_fds) {}
+
+    int num_points() const override { return num_points_; }
+    const vector<int> &net() const override { return net_; }
+    bool failed() const override { return failed_; }
+
+    void weights_reset(const vector<double> &weights) override
+    {
+        if (all_of(weights.begin(), weights.begin() + num_points_, [](double w)
+                   { return w == 1.0; }))
+        {
+            broadcast(ShardFrame{SHARD_RESET_WEIGHTS, {}});
+            return;
+        }
+        ShardFrame set{SHARD_SET_WEIGHTS, {}};
+        for (int p = 0; p < num_points_; ++p)
+            set.put(weights[p]);
+        broadcast(set);
+    }
+
+    void weights_doubled(const vector<int> &points) override
+    {
+        ShardFrame doubling{SHARD_DOUBLE, {}};
+        for (int point_idx : points)
+            doubling.put(point_idx);
+        broadcast(doubling);
+    }
+
+    void build_net(double weight_threshold, const vector<double> &, const function<bool()> &cancelled) override
+    {
+        net_.clear();
+        broadcast(ShardFrame{SHARD_BEGIN_NET, {}});
+        int last_added = -1;
+
+        while (!failed_ && !cancelled())
+        {
+            ShardFrame next{SHARD_NEXT, {}};
+            next.put(last_added);
+            next.put(weight_threshold);
+            broadcast(next);
+
+            double max_weight = -1.0;
+            int best_range = -1, best_point = -1;
+            ShardFrame reply;
+            for (int fd : worker_fds_)
+            {
+                if (!receive(fd, SHARD_CANDIDATE, reply))
+                    return;
+                size_t pos = 0;
+                double weight = reply.get<double>(pos);
+                int range = reply.get<int>(pos);
+                int point = reply.get<int>(pos);
+                // Workers hold increasing range slices, so '>' keeps the lowest index on ties.
+                if (range >= 0 && weight > max_weight)
+                {
+                    max_weight = weight;
+                    best_range = range;
+                    best_point = point;
+                }
+            }
+            if (best_range < 0)
+                break;
+            net_.push_back(best_point);
+            last_added = best_point;
+        }
+    }
+
+    int verify_net(vector<int> &missed_points, const function<bool()> &) override
+    {
+        broadcast(ShardFrame{SHARD_VERIFY, {}});
+        ShardFrame reply;
+        int missed = -1;
+        for (int fd : worker_fds_)
+        {
+            if (!receive(fd, SHARD_MISSED, reply))
+                return -1;
+            size_t pos = 0;
+            int range = reply.get<int>(pos);
+            if (range >= 0 && missed < 0)
+            {
+                missed = range;
+                missed_points.clear();
+                while (pos < reply.payload.size())
+                    missed_points.push_back(reply.get<int>(pos));
+            }
+        }
+        return missed;
+    }
 
-    Graph(int n, int m) : num_points(n), num_ranges(m), ranges_to_points(m)
+private:
+    void broadcast(const ShardFrame &frame)
     {
+        for (int fd : worker_fds_)
+            if (!send_frame(fd, frame))
+                fail();
     }
 
-    void add_edge(int range_idx, int point_idx)
+    bool receive(int fd, uint32_t expected, ShardFrame &frame)
     {
-        if (range_idx < num_ranges && point_idx < num_points)
+        if (!recv_frame(fd, frame) || frame.type != expected)
         {
-            ranges_to_points[range_idx].push_back(point_idx);
+            fail();
+            return false;
         }
+        return true;
     }
+
+    void fail()
+    {
+        if (!failed_)
+            cerr << "Lost connection to a shard worker\n";
+        failed_ = true;
+    }
+
+    int num_points_;
+    vector<int> worker_fds_;
+    vector<int> net_;
+    bool failed_ = false;
 };
 
-class HittingSetSolver
+// Starts (unless spawn_workers is false) and waits for num_workers workers on
+// socket_path, splits the ranges between them by edge count, and solves.
+int run_coordinator(const string &edge_path, int num_workers, const string &socket_path, bool spawn_workers,
+                    const CheckpointOptions &checkpoint)
 {
-public:
-    HittingSetSolver(const Graph &graph) : graph_(graph),
-                                           num_points_(graph.num_points),
-                                           num_ranges_(graph.num_ranges) {}
+    ExternalEdgeFile file;
+    if (!file.open(edge_path))
+        return 1;
+    num_workers = max(1, min(num_workers, max(1, file.num_ranges)));
+    // Same hash as the in-memory and --external modes, so a checkpoint carries over.
+    uint64_t hash = 0;
+    if (!checkpoint.path.empty() && !edge_file_hash(file, 64 << 20, hash))
+        return 1;
 
-    optional<unordered_set<int>> find_hitting_set()
+    signal(SIGPIPE, SIG_IGN);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (listen_fd < 0 || socket_path.size() >= sizeof(addr.sun_path))
+    {
+        cerr << "Could not create socket: " << socket_path << "\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+    unlink(socket_path.c_str());
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd, num_workers) < 0)
     {
-        if (num_points_ == 0)
-            return unordered_set<int>();
+        cerr << "Could not listen on " << socket_path << ": " << strerror(errno) << "\n";
+        close(listen_fd);
+        return 1;
+    }
 
-        for (int c_prime = 1; c_prime <= num_points_; c_prime *= 2)
+    vector<pid_t> children;
+    if (spawn_workers)
+    {
+        for (int w = 0; w < num_workers; ++w)
         {
-            cout << "Attempting to find hitting set with optimal size c' = " << c_prime << " xxx\n";
-            auto result = find_hitting_set_for_c(c_prime);
-            if (result)
+            pid_t pid = fork();
+            if (pid == 0)
             {
-                cout << "\n>>> Success! Found a hitting set.\n";
-                return result;
+                execl("/proc/self/exe", "paper1algo", "--shard-worker", socket_path.c_str(), edge_path.c_str(), (char *)nullptr);
+                _exit(127);
             }
-            cout << "Failed to find a hitting set assuming c' = " << c_prime
-                 << ". Doubling c'...\n\n";
+            if (pid > 0)
+                children.push_back(pid);
         }
-        return nullopt; // Should not be reached if a hitting set exists.
+    }
+    else
+    {
+        cout << "Waiting for " << num_workers << " worker(s) on " << socket_path << endl;
     }
 
-private:
-    optional<unordered_set<int>> find_hitting_set_for_c(int c_prime)
+    vector<int> worker_fds;
+    while ((int)worker_fds.size() < num_workers)
     {
-        // Initialize weights of all points to 1.
-        vector<double> weights(num_points_, 1.0);
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            cerr << "accept failed: " << strerror(errno) << "\n";
+            break;
+        }
+        worker_fds.push_back(fd);
+    }
+    close(listen_fd);
+    unlink(socket_path.c_str());
 
-        // Lemma 3.4. If there is a hitting set of size c, the doubling process cannot iterate more than 4c log(n / c) times, and the total weight will not exceed n4 / c 3 .
+    int status = 1;
+    if ((int)worker_fds.size() == num_workers)
+    {
+        // Contiguous, edge-balanced slices in connection order.
+        int lo = 0;
+        for (int w = 0; w < num_workers; ++w)
+        {
+            uint64_t target = file.num_edges * (w + 1) / num_workers;
+            int hi = lo;
+            while (hi < file.num_ranges && (file.offsets[hi + 1] <= target || hi == lo))
+                ++hi;
+            if (w == num_workers - 1)
+                hi = file.num_ranges;
+            ShardFrame assign{SHARD_ASSIGN, {}};
+            assign.put(lo);
+            assign.put(hi);
+            send_frame(worker_fds[w], assign);
+            lo = hi;
+        }
 
-        double max_iterations_double = 4.0 * c_prime * log((double)num_points_ / c_prime);
-        
-        int max_iterations = static_cast<int>(ceil(max_iterations_double));
+        cout << "Finding hitting set for the graph...\n"
+             << endl;
+        ShardedNetBackend backend(file.num_points, worker_fds);
+        HittingSetSolver solver(backend);
+        if (!checkpoint.path.empty())
+            setup_checkpointing(solver, checkpoint, 0, hash, file.num_points);
+        auto result = solver.find_hitting_set();
+        if (!checkpoint.path.empty() && !backend.failed())
+            unlink(checkpoint.path.c_str());
+        print_hitting_set(result);
+        status = result ? 0 : 1;
+    }
 
-        if (c_prime >= num_points_)
-            max_iterations = 1;
-        // Avoid log(x) where x<=1
+    for (int fd : worker_fds)
+    {
+        send_frame(fd, ShardFrame{SHARD_SHUTDOWN, {}});
+        close(fd);
+    }
+    for (pid_t pid : children)
+        waitpid(pid, nullptr, 0);
+    return status;
+}
 
-        cout << "Max iterations for c'=" << c_prime << " is " << max_iterations << endl;
+// Parses the integers of one line the way "istringstream >> int" does: stops at a
+// '#', at the end of the line, or at the first token that is not an int. Returns
+// the start of the next line.
+const char *parse_line_ints(const char *p, const char *end, vector<int> &out)
+{
+    auto is_space = [](char c)
+    { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; };
+    while (p < end && *p != '\n')
+    {
+        while (p < end && is_space(*p))
+            p++;
+        if (p == end || *p == '\n')
+            break;
+        bool negative = *p == '-';
+        const char *digits = p + (*p == '-' || *p == '+');
+        long long v = 0;
+        const char *q = digits;
+        while (q < end && *q >= '0' && *q <= '9' && v <= INT_MAX + 1ll)
+            v = v * 10 + (*q++ - '0');
+        if (q == digits || (q < end && *q >= '0' && *q <= '9') || v > INT_MAX + (long long)negative)
+            break; // not an int, or out of range: the rest of the line is ignored
+        out.push_back(static_cast<int>(negative ? -v : v));
+        p = q;
+    }
+    const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
 
-        for (int i = 0; i < max_iterations; ++i)
+// Loads a graph from a file. Format supported:
+//   First non-empty line: "n m" or "n m e"
+//   Following lines: pairs of integers (range_idx point_idx) representing edges.
+//   Comments starting with '#' are ignored. Both 0-based and 1-based indices are accepted.
+//
+// A regular file is mmap'd; anything else (a pipe, /dev/stdin, <(...)) or a file
+// that cannot be mapped is read into memory first. The text after the header is
+// then split into one chunk per
+// thread on line boundaries. Pass 1 parses each chunk into its own int buffer and,
+// for both possible pair alignments of the chunk, notes the first edge that is only
+// valid 1-based, so the index base is known without another pass over the edges.
+// Pass 2 counts the edges of every range per chunk, and pass 3 scatters each chunk's
+// edges to its precomputed offsets: a counting sort by range that keeps file order
+// within each range. Each pass runs on all threads.
+bool load_graph_from_file(const string &path, Graph &graph)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "Could not open file: " << path << "\n";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        cerr << "Could not open file: " << path << "\n";
+        return false;
+    }
+    size_t size = 0;
+    const char *text = "";
+    void *mapped = MAP_FAILED;
+    string buffer;
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            size = st.st_size;
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            text = static_cast<const char *>(mapped);
+        }
+    }
+    if (mapped == MAP_FAILED)
+    {
+        char chunk[1 << 16];
+        ssize_t got;
+        while ((got = read(fd, chunk, sizeof(chunk))) != 0)
+        {
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                ::close(fd);
+                cerr << "Could not read file: " << path << "\n";
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(got));
+        }
+        size = buffer.size();
+        text = buffer.data();
+    }
+    ::close(fd);
+    struct Unmap
+    {
+        void *addr;
+        size_t len;
+        ~Unmap()
         {
-            cout << "Iteration " << i + 1 << ":" << endl;
+            if (addr != MAP_FAILED)
+                munmap(addr, len);
+        }
+    } unmap{mapped, size};
+    const char *end = text + size;
+
+    // Header: the first line with any integers.
+    vector<int> header;
+    const char *body = text;
+    while (header.empty() && body < end)
+        body = parse_line_ints(body, end, header);
+    if (header.empty())
+    {
+        cerr << "No numeric input found in file: " << path << "\n";
+        return false;
+    }
+    if (header.size() < 2)
+    {
+        cerr << "First line must contain at least two integers: n m\n";
+        return false;
+    }
+    int n = header[0];
+    int m = header[1];
+    int e = header.size() >= 3 ? header[2] : -1;
+    if (n < 0 || m < 0)
+    {
+        cerr << "n and m must be non-negative\n";
+        return false;
+    }
 
-            // 1. Select a (1/2c')-net.
+    // One chunk per thread, but only as many threads as keep the per-chunk range
+    // counts (m ints each) small next to the text, and at least 1 MB of text each.
+    size_t body_size = end - body;
+    size_t num_chunks = min<size_t>({max(1u, thread::hardware_concurrency()),
+                                     max<size_t>(1, body_size >> 20),
+                                     max<size_t>(1, body_size / (8 * ((size_t)m + 1)))});
+    auto run_parallel = [&](size_t tasks, const function<void(size_t)> &fn)
+    {
+        vector<thread> workers;
+        for (size_t t = 1; t < tasks; ++t)
+            workers.emplace_back(fn, t);
+        fn(0);
+        for (auto &w : workers)
+            w.join();
+    };
 
-            double epsilon = 1.0 / (2.0 * c_prime);
-            unordered_set<int> net = find_weighted_epsilon_net(epsilon, weights);
+    // Buffer 0 holds the integers after "n m e" on the header line (already edge
+    // data); buffer k + 1 those of chunk k.
+    size_t num_buffers = num_chunks + 1;
+    vector<vector<int>> ints(num_buffers);
+    ints[0].assign(header.begin() + min<size_t>(3, header.size()), header.end());
+    vector<const char *> bounds(num_chunks + 1, end);
+    bounds[0] = body;
+    for (size_t k = 1; k < num_chunks; ++k)
+    {
+        const char *target = max(bounds[k - 1], body + body_size / num_chunks * k);
+        const char *nl = target < end ? static_cast<const char *>(memchr(target, '\n', end - target)) : nullptr;
+        bounds[k] = nl ? nl + 1 : end;
+    }
 
-            cout << "  - Computed a (1/" << 2 * c_prime << ")-net of size " << net.size() << ".";
+    // Pass 1: parse, and for each alignment q (pairs start at local index q) find
+    // the first pair that proves the file is 1-based.
+    auto one_based_witness = [&](int r, int p)
+    { return (r >= m || p >= n) && r - 1 >= 0 && r - 1 < m && p - 1 >= 0 && p - 1 < n; };
+    vector<array<long long, 2>> first_witness(num_buffers, {{-1, -1}});
+    auto find_witnesses = [&](size_t b)
+    {
+        const vector<int> &v = ints[b];
+        for (int q = 0; q < 2; ++q)
+            for (size_t j = q; j + 1 < v.size(); j += 2)
+                if (one_based_witness(v[j], v[j + 1]))
+                {
+                    first_witness[b][q] = (j - q) / 2;
+                    break;
+                }
+    };
+    run_parallel(num_chunks, [&](size_t k)
+                 {
+                     vector<int> &v = ints[k + 1];
+                     v.reserve((bounds[k + 1] - bounds[k]) / 4);
+                     for (const char *p = bounds[k]; p < bounds[k + 1];)
+                         p = parse_line_ints(p, bounds[k + 1], v);
+                     find_witnesses(k + 1); });
+    find_witnesses(0);
 
-            // 2. Verify if the net is a hitting set.
-            optional<int> missed_range_idx = verify_hitting_set(net);
+    // Global position of every buffer in the flattened integer sequence, which is
+    // read as (range, point) pairs; only the first e pairs count if e was given.
+    vector<long long> offset(num_buffers + 1, 0);
+    for (size_t b = 0; b < num_buffers; ++b)
+        offset[b + 1] = offset[b] + ints[b].size();
+    long long num_pairs = offset[num_buffers] / 2;
+    if (e >= 0)
+        num_pairs = min<long long>(num_pairs, e);
 
-            if (!missed_range_idx)
-            {
-                // Verification succeeded: the net is a hitting set.
-                cout << " Net is a valid hitting set.\n";
-                return net;
-            }
+    // The integer at global position g (g is in buffer b or a later one).
+    auto int_at = [&](size_t b, long long g)
+    {
+        while (g >= offset[b + 1])
+            b++;
+        return ints[b][g - offset[b]];
+    };
 
-            // Verification failed: the net missed at least one range.
-            int missed_idx = *missed_range_idx;
-            cout << " Net is not a hitting set. Missed range #" << missed_idx << ".\n";
+    bool need_subtract = false;
+    for (size_t b = 0; b < num_buffers && !need_subtract; ++b)
+    {
+        if (ints[b].empty())
+            continue;
+        int q = offset[b] % 2;
+        if (first_witness[b][q] >= 0 && (offset[b] + q) / 2 + first_witness[b][q] < num_pairs)
+            need_subtract = true;
+        // the pair that straddles the end of this buffer, if any
+        long long last = offset[b + 1] - 1;
+        if (last % 2 == 0 && last / 2 < num_pairs && one_based_witness(ints[b].back(), int_at(b + 1, last + 1)))
+            need_subtract = true;
+    }
+    int shift = need_subtract ? 1 : 0;
 
-            // 3. Double the weights of all points in the missed range.
-            cout << "  - Doubling weights for points in missed range: { ";
-            for (int point_idx : graph_.ranges_to_points[missed_idx])
-            {
-                weights[point_idx] *= 2.0;
-                cout << point_idx << " ";
-            }
-            cout << "}\n";
+    // Visits the pairs whose first integer is in buffer b, in file order.
+    auto for_each_pair = [&](size_t b, auto &&fn)
+    {
+        const vector<int> &v = ints[b];
+        for (long long j = offset[b] % 2; j < (long long)v.size(); j += 2)
+        {
+            long long pair_idx = (offset[b] + j) / 2;
+            if (pair_idx >= num_pairs)
+                break;
+            int r = v[j] - shift;
+            int p = (j + 1 < (long long)v.size() ? v[j + 1] : int_at(b + 1, offset[b] + j + 1)) - shift;
+            fn(r, p);
         }
+    };
+
+    // Pass 2: per-buffer edge counts of every range.
+    vector<vector<int>> count(num_buffers);
+    run_parallel(num_chunks, [&](size_t k)
+                 {
+                     for (size_t b = k; b < num_buffers; b += num_chunks)
+                     {
+                         count[b].assign(m, 0);
+                         for_each_pair(b, [&](int r, int p)
+                                       {
+                                           if (r >= 0 && r < m && p >= 0 && p < n)
+                                               count[b][r]++; });
+                     } });
+
+    // Counts become each buffer's first slot in the range; ranges are sized exactly.
+    graph = Graph(n, m);
+    run_parallel(num_chunks, [&](size_t k)
+                 {
+                     int lo = (long long)m * k / num_chunks, hi = (long long)m * (k + 1) / num_chunks;
+                     for (int r = lo; r < hi; ++r)
+                     {
+                         int total = 0;
+                         for (size_t b = 0; b < num_buffers; ++b)
+                         {
+                             int c = count[b][r];
+                             count[b][r] = total;
+                             total += c;
+                         }
+                         graph.ranges_to_points[r].resize(total);
+                     } });
+
+    // Pass 3: scatter. Out-of-range edges are reported afterwards, in file order.
+    vector<vector<pair<int, int>>> ignored(num_buffers);
+    run_parallel(num_chunks, [&](size_t k)
+                 {
+                     for (size_t b = k; b < num_buffers; b += num_chunks)
+                         for_each_pair(b, [&](int r, int p)
+                                       {
+                                           if (r >= 0 && r < m && p >= 0 && p < n)
+                                               graph.ranges_to_points[r][count[b][r]++] = p;
+                                           else
+                                               ignored[b].emplace_back(r, p); });
+                 });
+    for (const auto &list : ignored)
+        for (const auto &pr : list)
+            cerr << "Warning: ignoring out-of-range edge (" << pr.first << ", " << pr.second << ")\n";
+
+    return true;
+}
+
+// Server mode: graphs are loaded once and queries arrive over a Unix domain socket.
+// Each connection may pipeline any number of newline-terminated requests; they run
+// on a fixed worker pool and each response line is written back as soon as it is
+// ready (so responses can come back out of order), prefixed with the 0-based
+// index of the request on that connection:
+//   solve <graph> [-r <range>]... [+r <p1,p2,...>]...   ->  <id> ok size=<k> points=<p1,...> ms=<t>
+//   verify <graph> [<p1,p2,...>]                      ->  <id> valid | <id> missed range=<r>
+//   graphs                                            ->  <id> graphs <name>:<n>x<m> ...
+// "-r" drops a range and "+r" appends a new one for that request only; the resident
+// graph is never modified. Malformed requests get "<id> error <reason>".
+// At most MAX_QUEUED_PER_CONNECTION requests of one connection wait in the queue;
+// beyond that its reader stops reading the socket until workers catch up, so a
+// client that pipelines without bound is throttled instead of growing the server.
+static const int MAX_QUEUED_PER_CONNECTION = 256;
+static const size_t MAX_REQUEST_BYTES = 1 << 20;
+
+// Parses "1,5,9" into {1, 5, 9}; returns false on anything else.
+bool parse_int_list(const string &text, vector<int> &out)
+{
+    out.clear();
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t comma = text.find(',', pos);
+        string item = text.substr(pos, comma == string::npos ? string::npos : comma - pos);
+        char *end = nullptr;
+        long v = strtol(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0')
+            return false;
+        out.push_back(static_cast<int>(v));
+        if (comma == string::npos)
+            break;
+        pos = comma + 1;
+    }
+    return true;
+}
 
-        return nullopt;
+string format_point_list(const vector<int> &points)
+{
+    string out;
+    for (size_t k = 0; k < points.size(); ++k)
+    {
+        if (k)
+            out += ',';
+        out += to_string(points[k]);
     }
+    return out;
+}
 
-    // A "Net Finder" implementation.
+string handle_server_request(const string &line, const map<string, Graph> &graphs, SolverWorkspace &workspace)
+{
+    istringstream ss(line);
+    string command, name;
+    ss >> command;
 
-    unordered_set<int> find_weighted_epsilon_net(double epsilon, const vector<double> &weights)
+    if (command == "graphs")
     {
-        unordered_set<int> net;
-        double total_weight = accumulate(weights.begin(), weights.end(), 0.0);
-        double weight_threshold = epsilon * total_weight;
+        string out = "graphs";
+        for (auto &kv : graphs)
+            out += " " + kv.first + ":" + to_string(kv.second.num_points) + "x" + to_string(kv.second.num_ranges);
+        return out;
+    }
 
-        vector<bool> is_range_hit(num_ranges_, false);
-        bool found_heavy_unhit_range = true;
+    if (command != "solve" && command != "verify")
+        return "error unknown command '" + command + "'";
+    if (!(ss >> name))
+        return "error missing graph name";
+    auto it = graphs.find(name);
+    if (it == graphs.end())
+        return "error unknown graph '" + name + "'";
+    const Graph &graph = it->second;
 
-        while (found_heavy_unhit_range)
+    if (command == "verify")
+    {
+        string list;
+        vector<int> points;
+        if (ss >> list && !parse_int_list(list, points))
+            return "error bad point list";
+        vector<char> in_set(graph.num_points, 0);
+        for (int p : points)
         {
-            found_heavy_unhit_range = false;
-            int best_range_to_hit = -1;
-            double max_weight = -1.0;
-
-            // heaviest un-hit range
-            for (int i = 0; i < num_ranges_; ++i)
-            {
-                if (!is_range_hit[i])
-                {
-                    double current_range_weight = 0.0;
-                    for (int point_idx : graph_.ranges_to_points[i])
-                    {
-                        current_range_weight += weights[point_idx];
-                    }
-                    if (current_range_weight > weight_threshold && current_range_weight > max_weight)
-                    {
-                        max_weight = current_range_weight;
-                        best_range_to_hit = i;
-                        found_heavy_unhit_range = true;
-                    }
-                }
-            }
+            if (p < 0 || p >= graph.num_points)
+                return "error point " + to_string(p) + " out of range";
+            in_set[p] = 1;
+        }
+        for (int i = 0; i < graph.num_ranges; ++i)
+        {
+            const auto &range = graph.ranges_to_points[i];
+            if (!range.empty() && none_of(range.begin(), range.end(), [&](int p)
+                                          { return in_set[p]; }))
+                return "missed range=" + to_string(i);
+        }
+        return "valid";
+    }
 
-            if (found_heavy_unhit_range)
+    // solve, optionally with ranges removed from or added to the resident graph,
+    // which is seen through the edits rather than copied
+    GraphEdits edits;
+    string flag, arg;
+    while (ss >> flag)
+    {
+        if (!(ss >> arg))
+            return "error missing argument after " + flag;
+        vector<int> values;
+        if (!parse_int_list(arg, values))
+            return "error bad list '" + arg + "'";
+        if (flag == "-r")
+        {
+            for (int r : values)
             {
-                // Add the heaviest point from this heaviest range to the net
-                // because  it makes the most sense to add teh point with the most point in the net out of the heaviest range
-                // this parrt of the implementation has been left open to do whatever in the paper
-                const auto &points_in_range = graph_.ranges_to_points[best_range_to_hit];
-                int point_to_add = *max_element(points_in_range.begin(), points_in_range.end(),
-                                                [&](int a, int b)
-                                                { return weights[a] < weights[b]; });
-
-                net.insert(point_to_add);
-
-                // Mark all ranges hit by this new point
-                // all the ranges that the new point that we added are hit by it we need to mark them all
-                for (int i = 0; i < num_ranges_; ++i)
-                {
-                    if (!is_range_hit[i])
-                    {
-                        for (int p_idx : graph_.ranges_to_points[i])
-                        {
-                            if (p_idx == point_to_add)
-                            {
-                                is_range_hit[i] = true;
-                                break;
-                            }
-                        }
-                    }
-                }
+                if (r < 0 || r >= graph.num_ranges)
+                    return "error range " + to_string(r) + " out of range";
+                edits.removed.resize(graph.num_ranges, 0);
+                edits.removed[r] = 1;
             }
         }
-        return net;
+        else if (flag == "+r")
+        {
+            for (int p : values)
+                if (p < 0 || p >= graph.num_points)
+                    return "error point " + to_string(p) + " out of range";
+            edits.added.push_back(move(values));
+        }
+        else
+            return "error unknown option " + flag;
     }
 
-    // null if all hit
-    optional<int> verify_hitting_set(const unordered_set<int> &hitting_set) const
+    thread_local ostream null_log(nullptr);
+    auto start = chrono::steady_clock::now();
+    InMemoryNetBackend backend(graph, workspace, &edits);
+    HittingSetSolver solver(backend, workspace);
+    solver.set_log(null_log);
+    auto result = solver.find_hitting_set();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (!result)
+        return "error no hitting set found";
+
+    vector<int> points(result->begin(), result->end());
+    sort(points.begin(), points.end());
+    ostringstream out;
+    out << "ok size=" << points.size() << " points=" << format_point_list(points)
+        << " ms=" << fixed << setprecision(3) << ms;
+    return out.str();
+}
+
+struct ServerConnection
+{
+    int fd;
+    mutex write_mu;
+    int queued = 0; // requests in the shared queue, guarded by its mutex
+
+    explicit ServerConnection(int f) : fd(f) {}
+    // The socket closes once the reader and every queued request have let go,
+    // which tells the client that all of its responses have been sent.
+    ~ServerConnection() { close(fd); }
+
+    void send_line(const string &line)
     {
-        for (int i = 0; i < num_ranges_; ++i)
+        lock_guard<mutex> lock(write_mu);
+        string data = line + "\n";
+        size_t off = 0;
+        while (off < data.size())
         {
-            bool is_hit = false;
-            for (int point_idx : graph_.ranges_to_points[i])
-            {
-                if (hitting_set.count(point_idx))
-                {
-                    is_hit = true;
-                    break;
-                }
-            }
-            if (!is_hit)
-            {
-                return i; // This range was missed.
-            }
+            ssize_t w = write(fd, data.data() + off, data.size() - off);
+            if (w <= 0)
+                return; // client went away; drop the response
+            off += static_cast<size_t>(w);
         }
-        return nullopt; // All ranges were hit.
     }
+};
 
-    const Graph &graph_;
-    int num_points_;
-    int num_ranges_;
+struct ServerTask
+{
+    shared_ptr<ServerConnection> conn;
+    long long id;
+    string line;
 };
 
-void print_hitting_set(const optional<unordered_set<int>> &result)
+int run_server(const string &socket_path, const map<string, Graph> &graphs, int num_workers)
 {
-    if (result)
+    signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (listen_fd < 0 || socket_path.size() >= sizeof(addr.sun_path))
     {
-        cout << "\nFinal Hitting Set (point indices): { ";
-        for (int point_idx : *result)
+        cerr << "Could not create socket: " << socket_path << "\n";
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+    unlink(socket_path.c_str()); // stale socket from a previous run
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd, 64) < 0)
+    {
+        cerr << "Could not listen on " << socket_path << ": " << strerror(errno) << "\n";
+        close(listen_fd);
+        return 1;
+    }
+
+    // Shared with every worker and connection reader. run_server only returns once
+    // all of those threads have finished, so their references stay valid.
+    mutex queue_mu;
+    condition_variable queue_cv; // workers: a task is queued, or stopping
+    condition_variable space_cv; // readers: a connection's queue slot freed, or stopping
+    condition_variable done_cv;  // run_server: a reader exited
+    deque<ServerTask> queue;
+    bool stopping = false;
+    int active_readers = 0;
+    set<ServerConnection *> live_connections;
+
+    vector<thread> workers;
+    for (int w = 0; w < num_workers; ++w)
+    {
+        workers.emplace_back([&]()
+                             {
+                                 // One workspace per worker: buffers stay warm across requests.
+                                 SolverWorkspace workspace;
+                                 while (true)
+                                 {
+                                     ServerTask task;
+                                     {
+                                         unique_lock<mutex> lock(queue_mu);
+                                         queue_cv.wait(lock, [&]()
+                                                       { return stopping || !queue.empty(); });
+                                         if (stopping)
+                                             return;
+                                         task = move(queue.front());
+                                         queue.pop_front();
+                                         task.conn->queued--;
+                                     }
+                                     space_cv.notify_all();
+                                     string response = handle_server_request(task.line, graphs, workspace);
+                                     task.conn->send_line(to_string(task.id) + " " + response);
+                                 } });
+    }
+
+    // Queues one request, waiting while the connection has its quota queued.
+    // Returns false if the server is stopping.
+    auto enqueue = [&](ServerTask task)
+    {
+        unique_lock<mutex> lock(queue_mu);
+        space_cv.wait(lock, [&]()
+                      { return stopping || task.conn->queued < MAX_QUEUED_PER_CONNECTION; });
+        if (stopping)
+            return false;
+        task.conn->queued++;
+        queue.push_back(move(task));
+        queue_cv.notify_one();
+        return true;
+    };
+
+    cout << "Serving " << graphs.size() << " graph(s) on " << socket_path
+         << " with " << num_workers << " worker(s)" << endl;
+
+    while (true)
+    {
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0)
         {
-            cout << point_idx << " ";
+            if (errno == EINTR)
+                continue;
+            cerr << "accept failed: " << strerror(errno) << "\n";
+            break;
         }
-        cout << "}\n";
-        cout << "Size of hitting set: " << result->size() << endl;
+        auto conn = make_shared<ServerConnection>(client_fd);
+        {
+            lock_guard<mutex> lock(queue_mu);
+            live_connections.insert(conn.get());
+            active_readers++;
+        }
+        thread([conn, &enqueue, &queue_mu, &done_cv, &live_connections, &active_readers]()
+               {
+                   string pending;
+                   char buf[1 << 16];
+                   long long next_id = 0;
+                   ssize_t got;
+                   bool open = true;
+                   while (open && (got = read(conn->fd, buf, sizeof(buf))) > 0)
+                   {
+                       pending.append(buf, static_cast<size_t>(got));
+                       size_t start = 0, nl;
+                       while (open && (nl = pending.find('\n', start)) != string::npos)
+                       {
+                           string line = pending.substr(start, nl - start);
+                           start = nl + 1;
+                           if (!line.empty() && line.back() == '\r')
+                               line.pop_back();
+                           if (!line.empty())
+                               open = enqueue({conn, next_id++, move(line)});
+                       }
+                       pending.erase(0, start);
+                       if (open && pending.size() > MAX_REQUEST_BYTES)
+                       {
+                           conn->send_line(to_string(next_id) + " error request too long");
+                           open = false;
+                       }
+                   }
+                   lock_guard<mutex> lock(queue_mu);
+                   live_connections.erase(conn.get());
+                   active_readers--;
+                   done_cv.notify_all();
+               })
+            .detach();
     }
-    else
+
+    // Stop: unblock every reader, wait for them, then stop the workers. Queued
+    // requests are dropped; their clients see the connection close.
+    close(listen_fd);
+    {
+        unique_lock<mutex> lock(queue_mu);
+        stopping = true;
+        for (ServerConnection *conn : live_connections)
+            shutdown(conn->fd, SHUT_RDWR);
+        queue_cv.notify_all();
+        space_cv.notify_all();
+        done_cv.wait(lock, [&]()
+                     { return active_readers == 0; });
+    }
+    for (auto &w : workers)
+        w.join();
+    return 1;
+}
+
+// Replays an update script against a live graph, one update per line:
+//   +r <p1> <p2> ...   add a range containing the listed points
+//   -r <r>             remove range r
+//   +p <r1> <r2> ...   add a point contained in the listed ranges
+//   -p <p>             remove point p
+// and prints the solution delta after each update.
+int run_updates(const string &updates_path, Graph &graph)
+{
+    ifstream in(updates_path);
+    if (!in)
+    {
+        cerr << "Could not open file: " << updates_path << "\n";
+        return 1;
+    }
+
+    DynamicHittingSet dynamic(graph);
+    if (!dynamic.solve())
     {
         cout << "Could not find a hitting set." << endl;
+        return 1;
+    }
+    dynamic.take_delta();
+    cout << "Initial hitting set size: " << dynamic.solution().size() << endl;
+
+    auto print_points = [](const vector<int> &points)
+    {
+        cout << "{ ";
+        for (int p : points)
+            cout << p << " ";
+        cout << "}";
+    };
+
+    string line;
+    int update_no = 0;
+    while (getline(in, line))
+    {
+        auto pos = line.find('#');
+        if (pos != string::npos)
+            line = line.substr(0, pos);
+        istringstream ss(line);
+        string op;
+        if (!(ss >> op))
+            continue;
+        vector<int> args;
+        int x;
+        while (ss >> x)
+            args.push_back(x);
+
+        if (op == "+r")
+            dynamic.add_range(args);
+        else if (op == "-r" && args.size() == 1)
+            dynamic.remove_range(args[0]);
+        else if (op == "+p")
+            dynamic.add_point(args);
+        else if (op == "-p" && args.size() == 1)
+            dynamic.remove_point(args[0]);
+        else
+        {
+            cerr << "Warning: ignoring malformed update: " << line << "\n";
+            continue;
+        }
+
+        auto delta = dynamic.take_delta();
+        cout << "Update " << ++update_no << " (" << line << "): size=" << dynamic.solution().size() << " added=";
+        print_points(delta.added);
+        cout << " removed=";
+        print_points(delta.removed);
+        if (delta.resolved)
+            cout << " (full re-solve)";
+        cout << "\n";
     }
+
+    vector<int> final_set = dynamic.solution();
+    sort(final_set.begin(), final_set.end());
+    cout << "\nFinal Hitting Set (point indices): ";
+    print_points(final_set);
+    cout << "\nSize of hitting set: " << final_set.size() << endl;
+    return 0;
 }
 
 int main(int argc, char **argv)
@@ -229,123 +2325,188 @@ int main(int argc, char **argv)
     // Or set environment variable INPUT_GRAPH_FILE to the path before running.
     // If no file is provided, the program falls back to the built-in example.
 
-    Graph graph(0, 0);
-    bool loaded_from_file = false;
-
-    // Helper: load graph from a file. Format supported:
-    //   First non-empty line: "n m" or "n m e"
-    //   Following lines: pairs of integers (range_idx point_idx) representing edges.
-    //   Comments starting with '#' are ignored. Both 0-based and 1-based indices are accepted.
-    auto load_graph_from_file = [&](const string &path) -> bool
+    // Server mode:
+    //   paper1algocopy.exe --serve <socket-path> [--threads N] <name>=<graph-file> ...
+    if (argc > 1 && string(argv[1]) == "--serve")
     {
-        ifstream in(path);
-        if (!in)
+        if (argc < 4)
         {
-            cerr << "Could not open file: " << path << "\n";
-            return false;
+            cerr << "Usage: " << argv[0] << " --serve <socket-path> [--threads N] <name>=<graph-file> ...\n";
+            return 1;
         }
-
-        string line;
-        vector<vector<int>> lines_ints;
-        while (getline(in, line))
+        string socket_path = argv[2];
+        int num_workers = max(1u, thread::hardware_concurrency());
+        map<string, Graph> graphs;
+        for (int a = 3; a < argc; ++a)
         {
-            auto pos = line.find('#');
-            if (pos != string::npos)
-                line = line.substr(0, pos);
-            istringstream ss(line);
-            int x;
-            vector<int> ints;
-            while (ss >> x)
-                ints.push_back(x);
-            if (!ints.empty())
-                lines_ints.push_back(move(ints));
+            string arg = argv[a];
+            if (arg == "--threads" && a + 1 < argc)
+            {
+                num_workers = max(1, atoi(argv[++a]));
+                continue;
+            }
+            size_t eq = arg.find('=');
+            string name = eq == string::npos ? arg : arg.substr(0, eq);
+            string path = eq == string::npos ? arg : arg.substr(eq + 1);
+            Graph loaded(0, 0);
+            if (!load_graph_from_file(path, loaded))
+                return 1;
+            graphs.emplace(name, move(loaded));
         }
+        return run_server(socket_path, graphs, num_workers);
+    }
 
-        if (lines_ints.empty())
+    // Incremental mode:
+    //   paper1algocopy.exe --updates <update-file> <graph-file>
+    if (argc > 1 && string(argv[1]) == "--updates")
+    {
+        if (argc < 4)
         {
-            cerr << "No numeric input found in file: " << path << "\n";
-            return false;
+            cerr << "Usage: " << argv[0] << " --updates <update-file> <graph-file>\n";
+            return 1;
         }
+        Graph live(0, 0);
+        if (!load_graph_from_file(argv[3], live))
+            return 1;
+        return run_updates(argv[2], live);
+    }
 
-        if (lines_ints[0].size() < 2)
+    // Sharded mode over an edge file from --build-external:
+    //   paper1algocopy.exe --coordinator <edge-file> [--workers K] [--socket path] [--no-spawn] [checkpoint options]
+    //   paper1algocopy.exe --shard-worker <socket-path> <edge-file>
+    if (argc > 1 && string(argv[1]) == "--coordinator")
+    {
+        if (argc < 3)
         {
-            cerr << "First line must contain at least two integers: n m\n";
-            return false;
+            cerr << "Usage: " << argv[0] << " --coordinator <edge-file> [--workers K] [--socket path] [--no-spawn]"
+                 << " [--checkpoint <file>] [--checkpoint-every <s>] [--resume <file>]\n";
+            return 1;
         }
-
-        int n = lines_ints[0][0];
-        int m = lines_ints[0][1];
-        int e = -1;
-        if (lines_ints[0].size() >= 3)
-            e = lines_ints[0][2];
-
-        vector<int> remaining_ints;
-        for (size_t j = 0; j < lines_ints[0].size(); ++j)
-            if (j >= 3)
-                remaining_ints.push_back(lines_ints[0][j]);
-        for (size_t i = 1; i < lines_ints.size(); ++i)
-            for (int v : lines_ints[i])
-                remaining_ints.push_back(v);
-
-        vector<pair<int, int>> edges;
-        if (e >= 0)
+        int num_workers = max(1u, thread::hardware_concurrency());
+        string socket_path = "/tmp/hs-coordinator-" + to_string(getpid()) + ".sock";
+        bool spawn_workers = true;
+        CheckpointOptions checkpoint;
+        for (int a = 3; a < argc; ++a)
         {
-            for (size_t k = 0; k + 1 < remaining_ints.size() && (int)edges.size() < e; k += 2)
-                edges.emplace_back(remaining_ints[k], remaining_ints[k + 1]);
+            string arg = argv[a];
+            if (arg == "--workers" && a + 1 < argc)
+                num_workers = max(1, atoi(argv[++a]));
+            else if (arg == "--socket" && a + 1 < argc)
+                socket_path = argv[++a];
+            else if (arg == "--no-spawn")
+                spawn_workers = false;
+            else if (a + 1 < argc && checkpoint.parse(arg, argv[a + 1]))
+                ++a;
         }
-        else
+        return run_coordinator(argv[2], num_workers, socket_path, spawn_workers, checkpoint);
+    }
+    if (argc > 1 && string(argv[1]) == "--shard-worker")
+    {
+        if (argc < 4)
         {
-            for (size_t k = 0; k + 1 < remaining_ints.size(); k += 2)
-                edges.emplace_back(remaining_ints[k], remaining_ints[k + 1]);
+            cerr << "Usage: " << argv[0] << " --shard-worker <socket-path> <edge-file>\n";
+            return 1;
         }
+        return run_shard_worker(argv[2], argv[3]);
+    }
+
+    // Streaming mode, ranges one per line on stdin (no "n m e" header):
+    //   paper1algocopy.exe --stream [--max-point N]
+    if (argc > 1 && string(argv[1]) == "--stream")
+    {
+        int max_point = (1 << 24) - 1;
+        if (argc >= 4 && string(argv[2]) == "--max-point")
+            max_point = max(0, atoi(argv[3]));
+        ios::sync_with_stdio(false);
+        cin.tie(nullptr);
+        return run_stream(cin, max_point);
+    }
 
-        bool need_subtract = false;
-        for (auto &pr : edges)
+    // Out-of-core mode:
+    //   paper1algocopy.exe --build-external <graph-file> <edge-file> [--memory-mb N]
+    //   paper1algocopy.exe --external <edge-file> [--block-kb N] [checkpoint options]
+    if (argc > 1 && string(argv[1]) == "--build-external")
+    {
+        if (argc < 4)
         {
-            int r = pr.first;
-            int p = pr.second;
-            if (r >= m || p >= n)
-            {
-                if (r - 1 >= 0 && r - 1 < m && p - 1 >= 0 && p - 1 < n)
-                {
-                    need_subtract = true;
-                    break;
-                }
-            }
+            cerr << "Usage: " << argv[0] << " --build-external <graph-file> <edge-file> [--memory-mb N]\n";
+            return 1;
         }
-
-        if (need_subtract)
+        size_t memory_mb = 1024;
+        if (argc >= 6 && string(argv[4]) == "--memory-mb")
+            memory_mb = max(1, atoi(argv[5]));
+        return build_external_edge_file(argv[2], argv[3], memory_mb << 20) ? 0 : 1;
+    }
+    if (argc > 1 && string(argv[1]) == "--external")
+    {
+        if (argc < 3)
+        {
+            cerr << "Usage: " << argv[0] << " --external <edge-file> [--block-kb N] [--checkpoint <file>] [--checkpoint-every <s>] [--resume <file>]\n";
+            return 1;
+        }
+        size_t block_kb = 64 << 10;
+        CheckpointOptions checkpoint;
+        for (int a = 3; a + 1 < argc; a += 2)
         {
-            for (auto &pr : edges)
+            string arg = argv[a];
+            if (arg == "--block-kb")
+                block_kb = max(1, atoi(argv[a + 1]));
+            else if (!checkpoint.parse(arg, argv[a + 1]))
             {
-                pr.first -= 1;
-                pr.second -= 1;
+                cerr << "Unknown option: " << arg << "\n";
+                return 1;
             }
         }
+        return run_external(argv[2], block_kb << 10, checkpoint);
+    }
 
-        graph = Graph(n, m);
-        for (auto &pr : edges)
+    // Options for the default mode, before the graph file:
+    //   --deadline <seconds>   stop after this much wall-clock time (counted from
+    //                          startup) and report the best hitting set found so far
+    //   --cache-dir <dir>      consult and fill the solution cache in <dir>
+    //                          (default: $HS_CACHE_DIR; no caching if neither is set)
+    //   --cache-mb <N>         size cap of the cache directory (default 256)
+    //   --checkpoint <file>    save the solver state to <file> periodically; it is
+    //                          removed once the solve finishes
+    //   --checkpoint-every <s> seconds between checkpoints (default 60)
+    //   --resume <file>        like --checkpoint, but first continue from <file> if it
+    //                          exists; the result is identical to an uninterrupted run
+    auto start_time = chrono::steady_clock::now();
+    double deadline_seconds = -1.0;
+    const char *cache_env = getenv("HS_CACHE_DIR");
+    string cache_dir = cache_env ? cache_env : "";
+    uint64_t cache_mb = 256;
+    CheckpointOptions checkpoint;
+    int arg_idx = 1;
+    while (arg_idx + 1 < argc && string(argv[arg_idx]).rfind("--", 0) == 0)
+    {
+        string option = argv[arg_idx];
+        if (option == "--deadline")
+            deadline_seconds = atof(argv[arg_idx + 1]);
+        else if (option == "--cache-dir")
+            cache_dir = argv[arg_idx + 1];
+        else if (option == "--cache-mb")
+            cache_mb = max(1, atoi(argv[arg_idx + 1]));
+        else if (!checkpoint.parse(option, argv[arg_idx + 1]))
         {
-            if (pr.first >= 0 && pr.first < m && pr.second >= 0 && pr.second < n)
-                graph.add_edge(pr.first, pr.second);
-            else
-                cerr << "Warning: ignoring out-of-range edge (" << pr.first << ", " << pr.second << ")\n";
+            cerr << "Unknown option: " << option << "\n";
+            return 1;
         }
+        arg_idx += 2;
+    }
 
-        return true;
-    };
+    Graph graph(0, 0);
+    bool loaded_from_file = false;
 
-    // Prefer command-line argument if provided
-    if (argc > 1)
+    // Prefer command-line argument if provided. A path that fails to load is an
+    // error, never a reason to solve the built-in example instead.
+    const char *envp = getenv("INPUT_GRAPH_FILE");
+    if (argc > arg_idx || envp != nullptr)
     {
-        string path = argv[1];
-        loaded_from_file = load_graph_from_file(path);
-    }
-    else
-    {
-        const char *envp = getenv("INPUT_GRAPH_FILE");
-        if (envp != nullptr)
-            loaded_from_file = load_graph_from_file(string(envp));
+        string path = argc > arg_idx ? argv[arg_idx] : envp;
+        if (!load_graph_from_file(path, graph))
+            return 1;
+        loaded_from_file = true;
     }
 
     if (!loaded_from_file)
@@ -396,10 +2557,93 @@ int main(int argc, char **argv)
     cout << "Finding hitting set for the graph...\n"
          << endl;
 
+    auto print_anytime = [&](const AnytimeResult &best)
+    {
+        print_hitting_set(best.hitting_set);
+        if (best.timed_out)
+            cout << "Deadline of " << deadline_seconds << "s reached: returning the best hitting set found so far." << endl;
+        cout << "Found by: " << (best.c_prime > 0 ? "doubling with c' = " + to_string(best.c_prime) : string("greedy seed")) << endl;
+        cout << "Lower bound on optimal size: " << best.lower_bound;
+        if (best.lower_bound > 0)
+            cout << " (approximation ratio at most " << fixed << setprecision(4)
+                 << (double)best.hitting_set->size() / best.lower_bound << ")";
+        cout << endl;
+    };
+
+    // A run that hit its deadline is not cached: its result depends on timing.
+    unique_ptr<SolutionCache> cache;
+    string cache_tag = deadline_seconds >= 0 ? "anytime" : "approx";
+    CacheEntry entry, ilp_entry;
+    if (!cache_dir.empty())
+    {
+        cache.reset(new SolutionCache(cache_dir, cache_mb << 20, graph));
+        bool hit = cache->lookup(cache_tag, entry);
+        if (cache->lookup("ilp", ilp_entry))
+            entry.ilp_optimum = ilp_entry.ilp_optimum;
+        if (hit)
+        {
+            cout << "Loaded from cache (originally solved in " << entry.solve_ms << " ms)." << endl;
+            unordered_set<int> cached(entry.hitting_set.begin(), entry.hitting_set.end());
+            if (deadline_seconds >= 0)
+                print_anytime(AnytimeResult{move(cached), entry.c_prime, entry.lower_bound, false});
+            else
+                print_hitting_set(move(cached));
+            if (entry.ilp_optimum >= 0)
+                cout << "Optimal size (cached ILP result): " << entry.ilp_optimum << endl;
+            return 0;
+        }
+    }
+
     HittingSetSolver solver(graph);
+    if (!checkpoint.path.empty())
+    {
+        uint64_t num_edges = 0;
+        setup_checkpointing(solver, checkpoint, deadline_seconds >= 0 ? 1 : 0, instance_hash(graph, num_edges), graph.num_points);
+    }
+    // The run is over (solved, or the deadline made it final): the checkpoint is spent.
+    auto drop_checkpoint = [&]()
+    {
+        if (!checkpoint.path.empty())
+            unlink(checkpoint.path.c_str());
+    };
+    auto solve_start = chrono::steady_clock::now();
+    auto store_in_cache = [&](const unordered_set<int> &hitting_set)
+    {
+        if (!cache)
+            return;
+        entry.hitting_set.assign(hitting_set.begin(), hitting_set.end());
+        entry.solve_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - solve_start).count();
+        cache->store(cache_tag, entry);
+    };
+
+    if (deadline_seconds >= 0)
+    {
+        auto deadline = start_time + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(deadline_seconds));
+        AnytimeResult best = solver.find_hitting_set_anytime(deadline);
+        drop_checkpoint();
+        print_anytime(best);
+        if (!best.timed_out)
+        {
+            entry.c_prime = best.c_prime;
+            entry.lower_bound = best.lower_bound;
+            store_in_cache(*best.hitting_set);
+        }
+        if (entry.ilp_optimum >= 0)
+            cout << "Optimal size (cached ILP result): " << entry.ilp_optimum << endl;
+        return 0;
+    }
+
     auto result = solver.find_hitting_set();
+    drop_checkpoint();
 
     print_hitting_set(result);
+    if (result)
+    {
+        entry.c_prime = solver.solved_c_prime();
+        store_in_cache(*result);
+    }
+    if (entry.ilp_optimum >= 0)
+        cout << "Optimal size (cached ILP result): " << entry.ilp_optimum << endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,449 +1,18 @@
 #!/bin/bash
 # Comprehensive test suite for Hitting Set algorithms
 # Tests various graph sizes and computes approximation ratios
-
-OUTPUT_FILE="experiment_results.txt"
-TIMESTAMP=$(date '+%Y-%m-%d %H:%M:%S')
-
-echo "========================================" > "$OUTPUT_FILE"
-echo "Hitting Set Algorithm Experiment Results" >> "$OUTPUT_FILE"
-echo "Run Date: $TIMESTAMP" >> "$OUTPUT_FILE"
-echo "========================================" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-
-# Counter for tests
-TEST_NUM=0
-TOTAL_TESTS=0
-SUCCESSFUL_ILP=0
-FAILED_ILP=0
-TOTAL_RATIO=0
-
-# Arrays to store test results for chart generation
-declare -a TEST_NAMES
-declare -a TEST_N
-declare -a TEST_M
-declare -a TEST_E
-declare -a TEST_APPROX
-declare -a TEST_OPT
-declare -a TEST_RATIO
-declare -a TEST_TIME
-
-# Function to run a single test
-run_test() {
-    local n=$1      # number of points
-    local m=$2      # number of ranges
-    local p=$3      # edge probability
-    local seed=$4   # random seed
-    local name=$5   # test name
-    
-    TEST_NUM=$((TEST_NUM + 1))
-    TOTAL_TESTS=$((TOTAL_TESTS + 1))
-    
-    local test_file="test_${TEST_NUM}.txt"
-    
-    echo "Running Test #$TEST_NUM: $name (n=$n, m=$m, p=$p, seed=$seed)..."
-    
-    # Generate graph
-    ./gen_graphs $n $m $p $seed "$test_file" > /dev/null 2>&1
-    
-    if [ ! -f "$test_file" ]; then
-        echo "  ERROR: Failed to generate graph"
-        echo "Test #$TEST_NUM: $name - FAILED (generation error)" >> "$OUTPUT_FILE"
-        echo "" >> "$OUTPUT_FILE"
-        return
-    fi
-    
-    # Read actual edge count
-    local e=$(head -1 "$test_file" | awk '{print $3}')
-    
-    # Run approximation algorithm with timeout
-    echo "  Running approximation algorithm..."
-    local approx_start=$(date +%s.%N)
-    timeout 30s ./paper1algo "$test_file" > "approx_${TEST_NUM}.out" 2>&1
-    local approx_exit=$?
-    local approx_end=$(date +%s.%N)
-    local approx_time=$(echo "$approx_end - $approx_start" | bc)
-    
-    if [ $approx_exit -ne 0 ]; then
-        echo "  TIMEOUT/ERROR in approximation"
-        echo "Test #$TEST_NUM: $name - FAILED (approximation timeout)" >> "$OUTPUT_FILE"
-        echo "" >> "$OUTPUT_FILE"
-        rm -f "$test_file" "approx_${TEST_NUM}.out"
-        return
-    fi
-    
-    local approx_size=$(grep "Size of hitting set:" "approx_${TEST_NUM}.out" | tail -1 | awk '{print $NF}')
-    
-    if [ -z "$approx_size" ]; then
-        echo "  ERROR: Could not extract approximation size"
-        echo "Test #$TEST_NUM: $name - FAILED (no solution)" >> "$OUTPUT_FILE"
-        echo "" >> "$OUTPUT_FILE"
-        rm -f "$test_file" "approx_${TEST_NUM}.out"
-        return
-    fi
-    
-    # Try ILP with timeout (only for small/medium graphs)
-    local ilp_size="N/A"
-    local ilp_time="N/A"
-    local ratio="N/A"
-    local ilp_status="NOT RUN"
-    
-    if [ $n -le 200 ]; then
-        echo "  Running ILP solver..."
-        local ilp_start=$(date +%s.%N)
-        timeout 120s ./solver "$test_file" > "ilp_${TEST_NUM}.out" 2>&1
-        local ilp_exit=$?
-        local ilp_end=$(date +%s.%N)
-        ilp_time=$(echo "$ilp_end - $ilp_start" | bc)
-        
-        if [ $ilp_exit -eq 0 ]; then
-            ilp_size=$(grep "Optimal Size:" "ilp_${TEST_NUM}.out" | awk '{print $NF}')
-            if [ -n "$ilp_size" ] && [ "$ilp_size" -gt 0 ]; then
-                ratio=$(echo "scale=4; $approx_size / $ilp_size" | bc)
-                TOTAL_RATIO=$(echo "$TOTAL_RATIO + $ratio" | bc)
-                SUCCESSFUL_ILP=$((SUCCESSFUL_ILP + 1))
-                ilp_status="SUCCESS"
-                echo "  ILP completed: optimal=$ilp_size, ratio=$ratio"
-            else
-                ilp_status="ERROR"
-                FAILED_ILP=$((FAILED_ILP + 1))
-            fi
-        else
-            ilp_status="TIMEOUT"
-            ilp_time=">120s"
-            FAILED_ILP=$((FAILED_ILP + 1))
-            echo "  ILP timeout (>120s)"
-        fi
-    else
-        ilp_status="SKIPPED (too large)"
-        echo "  ILP skipped (graph too large)"
-    fi
-    
-    # Write results to file
-    echo "----------------------------------------" >> "$OUTPUT_FILE"
-    echo "Test #$TEST_NUM: $name" >> "$OUTPUT_FILE"
-    echo "----------------------------------------" >> "$OUTPUT_FILE"
-    echo "Graph Parameters:" >> "$OUTPUT_FILE"
-    echo "  - Points (n):        $n" >> "$OUTPUT_FILE"
-    echo "  - Ranges (m):        $m" >> "$OUTPUT_FILE"
-    echo "  - Edge Probability:  $p" >> "$OUTPUT_FILE"
-    echo "  - Actual Edges:      $e" >> "$OUTPUT_FILE"
-    echo "  - Random Seed:       $seed" >> "$OUTPUT_FILE"
-    echo "" >> "$OUTPUT_FILE"
-    echo "Results:" >> "$OUTPUT_FILE"
-    echo "  - Approximation Size:  $approx_size" >> "$OUTPUT_FILE"
-    echo "  - Approximation Time:  ${approx_time}s" >> "$OUTPUT_FILE"
-    echo "  - ILP Optimal Size:    $ilp_size" >> "$OUTPUT_FILE"
-    echo "  - ILP Time:            $ilp_time" >> "$OUTPUT_FILE"
-    echo "  - ILP Status:          $ilp_status" >> "$OUTPUT_FILE"
-    if [ "$ratio" != "N/A" ]; then
-        echo "  - Approximation Ratio: $ratio" >> "$OUTPUT_FILE"
-    fi
-    echo "" >> "$OUTPUT_FILE"
-    
-    # Store results for chart generation
-    TEST_NAMES[$TEST_NUM]="$name"
-    TEST_N[$TEST_NUM]=$n
-    TEST_M[$TEST_NUM]=$m
-    TEST_E[$TEST_NUM]=$e
-    TEST_APPROX[$TEST_NUM]=$approx_size
-    TEST_OPT[$TEST_NUM]=$ilp_size
-    TEST_RATIO[$TEST_NUM]=$ratio
-    TEST_TIME[$TEST_NUM]=$approx_time
-    
-    # Clean up
-    rm -f "$test_file" "approx_${TEST_NUM}.out" "ilp_${TEST_NUM}.out"
-}
-
-echo "Starting experiment suite..."
-echo ""
-
-# Tiny tests (can solve optimally)
-echo "=== TINY TEST CASES ===" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-run_test 10 5 0.5 1001 "Tiny Dense"
-run_test 15 8 0.3 1002 "Tiny Medium Density"
-run_test 20 10 0.2 1003 "Tiny Sparse"
-
-# Small tests (can solve optimally)
-echo "=== SMALL TEST CASES ===" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-run_test 50 20 0.1 2001 "Small Dense"
-run_test 50 25 0.05 2002 "Small Medium Density"
-run_test 60 30 0.03 2003 "Small Sparse"
-
-# Medium tests (ILP might be slow but doable)
-echo "=== MEDIUM TEST CASES ===" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-run_test 100 50 0.05 3001 "Medium Dense"
-run_test 120 60 0.03 3002 "Medium Medium Density"
-run_test 150 75 0.02 3003 "Medium Sparse"
-
-# Large tests (ILP impractical - approximation only)
-echo "=== LARGE TEST CASES (Approximation Only) ===" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-run_test 300 150 0.02 4001 "Large Sparse"
-run_test 500 200 0.015 4002 "Very Large Sparse"
-run_test 1000 400 0.01 4003 "Extra Large Sparse"
-
-# Special structure tests
-echo "=== SPECIAL STRUCTURE TEST CASES ===" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-run_test 100 20 0.1 5001 "Many Points, Few Ranges"
-run_test 50 100 0.1 5002 "Few Points, Many Ranges"
-run_test 80 80 0.05 5003 "Balanced Graph"
-
-# Generate summary statistics
-echo "========================================" >> "$OUTPUT_FILE"
-echo "SUMMARY STATISTICS" >> "$OUTPUT_FILE"
-echo "========================================" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-echo "Total Tests Run:           $TOTAL_TESTS" >> "$OUTPUT_FILE"
-echo "ILP Successful:            $SUCCESSFUL_ILP" >> "$OUTPUT_FILE"
-echo "ILP Failed/Timeout:        $FAILED_ILP" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-
-if [ $SUCCESSFUL_ILP -gt 0 ]; then
-    AVG_RATIO=$(echo "scale=4; $TOTAL_RATIO / $SUCCESSFUL_ILP" | bc)
-    echo "Average Approximation Ratio: $AVG_RATIO" >> "$OUTPUT_FILE"
-    echo "" >> "$OUTPUT_FILE"
-    echo "Interpretation:" >> "$OUTPUT_FILE"
-    echo "  - Ratio = 1.0:  Approximation found optimal solution" >> "$OUTPUT_FILE"
-    echo "  - Ratio < 2.0:  Excellent approximation" >> "$OUTPUT_FILE"
-    echo "  - Ratio < 3.0:  Good approximation" >> "$OUTPUT_FILE"
-    echo "  - Ratio < O(log n): Within theoretical bound" >> "$OUTPUT_FILE"
+#
+# The suite runs in-process (experiments.cpp): graphs are generated in memory and
+# the approximation and ILP runs share a thread pool instead of one process per
+# step. Options are passed through, e.g.
+#   ./run_experiments.sh --threads 8 --seeds 5 --ilp-timeout 60 --memory-mb 2048
+
+cd "$(dirname "$0")" || exit 1
+
+if [ ! -x ./experiments ] || [ experiments.cpp -nt ./experiments ] ||
+   [ hitting_set.h -nt ./experiments ] || [ ilp_model.h -nt ./experiments ]; then
+    echo "Building experiments..."
+    g++ experiments.cpp -o experiments -O2 -pthread -lglpk || exit 1
 fi
 
-echo "" >> "$OUTPUT_FILE"
-echo "========================================" >> "$OUTPUT_FILE"
-echo "ANALYSIS" >> "$OUTPUT_FILE"
-echo "========================================" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-echo "Key Observations:" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-echo "1. Scalability:" >> "$OUTPUT_FILE"
-echo "   - Approximation algorithm handles graphs with 1000+ points" >> "$OUTPUT_FILE"
-echo "   - ILP solver practical only for graphs with <200 points" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-echo "2. Quality vs Speed Trade-off:" >> "$OUTPUT_FILE"
-echo "   - Approximation: Fast but larger solution" >> "$OUTPUT_FILE"
-echo "   - ILP: Optimal but exponentially slower" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-echo "3. Approximation Quality:" >> "$OUTPUT_FILE"
-echo "   - Typically within 1.5-2x of optimal on random graphs" >> "$OUTPUT_FILE"
-echo "   - Sometimes finds optimal solution" >> "$OUTPUT_FILE"
-echo "   - Always within O(log n) theoretical guarantee" >> "$OUTPUT_FILE"
-echo "" >> "$OUTPUT_FILE"
-
-echo ""
-echo "========================================="
-echo "Experiment complete!"
-echo "Results written to: $OUTPUT_FILE"
-echo "Generating TEST_RESULTS_CHART.md..."
-echo "========================================="
-echo ""
-echo "Summary:"
-echo "  Total tests: $TOTAL_TESTS"
-echo "  ILP successful: $SUCCESSFUL_ILP"
-if [ $SUCCESSFUL_ILP -gt 0 ]; then
-    AVG_RATIO=$(echo "scale=4; $TOTAL_RATIO / $SUCCESSFUL_ILP" | bc)
-    echo "  Average approximation ratio: $AVG_RATIO"
-fi
-
-# Generate TEST_RESULTS_CHART.md
-CHART_FILE="TEST_RESULTS_CHART.md"
-echo "# Quick Reference: Test Results at a Glance" > "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "**Generated:** $TIMESTAMP" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "## All Test Cases - Approximation Ratios" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "| # | Test Name | n | m | Edges | Approx | Optimal | Ratio | Time(s) |" >> "$CHART_FILE"
-echo "|---|-----------|---|---|-------|--------|---------|-------|---------|" >> "$CHART_FILE"
-
-# Generate table rows
-for i in $(seq 1 $TOTAL_TESTS); do
-    name="${TEST_NAMES[$i]}"
-    n="${TEST_N[$i]}"
-    m="${TEST_M[$i]}"
-    e="${TEST_E[$i]}"
-    approx="${TEST_APPROX[$i]}"
-    opt="${TEST_OPT[$i]}"
-    ratio="${TEST_RATIO[$i]}"
-    time="${TEST_TIME[$i]}"
-    
-    # Format ratio display with star for near-optimal
-    ratio_display="$ratio"
-    if [ "$ratio" != "N/A" ]; then
-        ratio_num=$(echo "$ratio" | bc)
-        is_near_optimal=$(echo "$ratio_num < 1.10" | bc)
-        if [ "$is_near_optimal" -eq 1 ]; then
-            ratio_display="**$ratio** ⭐"
-        fi
-    fi
-    
-    echo "| $i | $name | $n | $m | $e | $approx | $opt | $ratio_display | $time |" >> "$CHART_FILE"
-done
-
-echo "" >> "$CHART_FILE"
-echo "⭐ = Near-optimal (ratio < 1.10)" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-# Statistics section
-echo "## Statistics Summary" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "\`\`\`" >> "$CHART_FILE"
-echo "Total Tests:                    $TOTAL_TESTS" >> "$CHART_FILE"
-echo "Tests with ILP comparison:      $SUCCESSFUL_ILP" >> "$CHART_FILE"
-echo "Tests approximation only:       $((TOTAL_TESTS - SUCCESSFUL_ILP))" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-if [ $SUCCESSFUL_ILP -gt 0 ]; then
-    AVG_RATIO=$(echo "scale=4; $TOTAL_RATIO / $SUCCESSFUL_ILP" | bc)
-    
-    # Find best and worst ratios
-    BEST_RATIO="999.0"
-    WORST_RATIO="0.0"
-    BEST_TEST=""
-    WORST_TEST=""
-    
-    for i in $(seq 1 $TOTAL_TESTS); do
-        ratio="${TEST_RATIO[$i]}"
-        if [ "$ratio" != "N/A" ]; then
-            is_better=$(echo "$ratio < $BEST_RATIO" | bc)
-            is_worse=$(echo "$ratio > $WORST_RATIO" | bc)
-            if [ "$is_better" -eq 1 ]; then
-                BEST_RATIO="$ratio"
-                BEST_TEST="#$i - ${TEST_NAMES[$i]}"
-            fi
-            if [ "$is_worse" -eq 1 ]; then
-                WORST_RATIO="$ratio"
-                WORST_TEST="#$i - ${TEST_NAMES[$i]}"
-            fi
-        fi
-    done
-    
-    echo "Average Approximation Ratio:    ${AVG_RATIO}x" >> "$CHART_FILE"
-    echo "Best Ratio:                     ${BEST_RATIO}x  ($BEST_TEST)" >> "$CHART_FILE"
-    echo "Worst Ratio:                    ${WORST_RATIO}x  ($WORST_TEST)" >> "$CHART_FILE"
-fi
-
-echo "" >> "$CHART_FILE"
-
-# Find timing statistics
-FASTEST_TIME="999999.0"
-SLOWEST_TIME="0.0"
-FASTEST_TEST=""
-SLOWEST_TEST=""
-
-for i in $(seq 1 $TOTAL_TESTS); do
-    time="${TEST_TIME[$i]}"
-    if [ -n "$time" ]; then
-        is_faster=$(echo "$time < $FASTEST_TIME" | bc)
-        is_slower=$(echo "$time > $SLOWEST_TIME" | bc)
-        if [ "$is_faster" -eq 1 ]; then
-            FASTEST_TIME="$time"
-            FASTEST_TEST="#$i - ${TEST_NAMES[$i]}"
-        fi
-        if [ "$is_slower" -eq 1 ]; then
-            SLOWEST_TIME="$time"
-            SLOWEST_TEST="#$i - ${TEST_NAMES[$i]}"
-        fi
-    fi
-done
-
-echo "Fastest Test:                   ${FASTEST_TIME}s ($FASTEST_TEST)" >> "$CHART_FILE"
-echo "Slowest Test:                   ${SLOWEST_TIME}s ($SLOWEST_TEST)" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-# Graph size limits
-MAX_ILP_N=0
-MAX_APPROX_N=0
-for i in $(seq 1 $TOTAL_TESTS); do
-    n="${TEST_N[$i]}"
-    opt="${TEST_OPT[$i]}"
-    if [ "$opt" != "N/A" ] && [ $n -gt $MAX_ILP_N ]; then
-        MAX_ILP_N=$n
-    fi
-    if [ $n -gt $MAX_APPROX_N ]; then
-        MAX_APPROX_N=$n
-    fi
-done
-
-echo "Max graph size solved by ILP:   $MAX_ILP_N points" >> "$CHART_FILE"
-echo "Max graph size by approx:       $MAX_APPROX_N points" >> "$CHART_FILE"
-echo "\`\`\`" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-# Performance trends
-echo "## Performance Trends" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "### Approximation Time vs Graph Size" >> "$CHART_FILE"
-echo "\`\`\`" >> "$CHART_FILE"
-for i in $(seq 1 $TOTAL_TESTS); do
-    n="${TEST_N[$i]}"
-    time="${TEST_TIME[$i]}"
-    echo "n=$n     → ${time}s" >> "$CHART_FILE"
-done
-echo "" >> "$CHART_FILE"
-echo "Growth: Roughly linear (polynomial time)" >> "$CHART_FILE"
-echo "\`\`\`" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-# Quality breakdown
-echo "## Quality Breakdown" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-
-if [ $SUCCESSFUL_ILP -gt 0 ]; then
-    EXCELLENT=0
-    GOOD=0
-    ACCEPTABLE=0
-    OUTSIDE=0
-    
-    for i in $(seq 1 $TOTAL_TESTS); do
-        ratio="${TEST_RATIO[$i]}"
-        if [ "$ratio" != "N/A" ]; then
-            ratio_num=$(echo "$ratio" | bc)
-            is_excellent=$(echo "$ratio_num < 1.30" | bc)
-            is_good=$(echo "$ratio_num >= 1.30 && $ratio_num < 1.50" | bc)
-            is_acceptable=$(echo "$ratio_num >= 1.50 && $ratio_num < 2.00" | bc)
-            
-            if [ "$is_excellent" -eq 1 ]; then
-                EXCELLENT=$((EXCELLENT + 1))
-            elif [ "$is_good" -eq 1 ]; then
-                GOOD=$((GOOD + 1))
-            elif [ "$is_acceptable" -eq 1 ]; then
-                ACCEPTABLE=$((ACCEPTABLE + 1))
-            else
-                OUTSIDE=$((OUTSIDE + 1))
-            fi
-        fi
-    done
-    
-    EXCELLENT_PCT=$(echo "scale=1; 100 * $EXCELLENT / $SUCCESSFUL_ILP" | bc)
-    GOOD_PCT=$(echo "scale=1; 100 * $GOOD / $SUCCESSFUL_ILP" | bc)
-    ACCEPTABLE_PCT=$(echo "scale=1; 100 * $ACCEPTABLE / $SUCCESSFUL_ILP" | bc)
-    
-    echo "### Excellent (Ratio < 1.3): $EXCELLENT tests (${EXCELLENT_PCT}%)" >> "$CHART_FILE"
-    echo "### Good (1.3 ≤ Ratio < 1.5): $GOOD tests (${GOOD_PCT}%)" >> "$CHART_FILE"
-    echo "### Acceptable (1.5 ≤ Ratio < 2.0): $ACCEPTABLE tests (${ACCEPTABLE_PCT}%)" >> "$CHART_FILE"
-    echo "### Outside Bound (Ratio ≥ 2.0): $OUTSIDE tests (0%)" >> "$CHART_FILE"
-    echo "" >> "$CHART_FILE"
-    echo "All results well within theoretical guarantee!" >> "$CHART_FILE"
-fi
-
-echo "" >> "$CHART_FILE"
-echo "## Key Insights" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "1. **Sparse graphs** tend to produce better approximation ratios" >> "$CHART_FILE"
-echo "2. **Graph structure** matters more than absolute size" >> "$CHART_FILE"
-echo "3. **All ratios** far better than O(log n) worst-case guarantee" >> "$CHART_FILE"
-echo "4. **Approximation algorithm** scales to large graphs where ILP fails" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "---" >> "$CHART_FILE"
-echo "" >> "$CHART_FILE"
-echo "*Auto-generated from \`run_experiments.sh\`*  " >> "$CHART_FILE"
-echo "*See \`experiment_results.txt\` for detailed raw data*" >> "$CHART_FILE"
-
-echo "Chart generated: $CHART_FILE"
-echo ""
+exec ./experiments "$@"
@@ -0,0 +1,215 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+// The solution cache of paper1algo and solver, and the instance hash that keys
+// both it and paper1algo's checkpoints.
+
+#include <unistd.h>
+#include "hitting_set.h"
+
+// FNV-1a over the canonical instance: n, m and each range's sorted, deduplicated
+// points. Ranges are fed one at a time, so an instance that is not in memory (an
+// edge file) hashes the same as the Graph it was built from.
+class InstanceHasher
+{
+public:
+    InstanceHasher(int num_points, int num_ranges)
+    {
+        mix(num_points);
+        mix(num_ranges);
+    }
+
+    template <class It>
+    void add_range(It begin, It end)
+    {
+        points_.assign(begin, end);
+        sort(points_.begin(), points_.end());
+        points_.erase(unique(points_.begin(), points_.end()), points_.end());
+        mix((int32_t)points_.size());
+        for (int p : points_)
+            mix(p);
+        num_edges_ += points_.size();
+    }
+
+    uint64_t value() const { return h_; }
+    uint64_t num_edges() const { return num_edges_; } // distinct edges so far
+
+private:
+    void mix(int32_t v)
+    {
+        for (int b = 0; b < 4; ++b)
+        {
+            h_ ^= (uint8_t)(v >> (8 * b));
+            h_ *= 1099511628211ull;
+        }
+    }
+
+    uint64_t h_ = 1469598103934665603ull;
+    uint64_t num_edges_ = 0;
+    vector<int> points_;
+};
+
+// num_edges receives the number of distinct edges.
+inline uint64_t instance_hash(const Graph &graph, uint64_t &num_edges)
+{
+    InstanceHasher hasher(graph.num_points, graph.num_ranges);
+    for (const auto &range : graph.ranges_to_points)
+        hasher.add_range(range.begin(), range.end());
+    num_edges = hasher.num_edges();
+    return hasher.value();
+}
+
+// On-disk solution cache. An entry is keyed by instance_hash and a tag naming the solver and its
+// parameters, one file per entry:
+//   <dir>/<instance-hash>-<tag>.hsc
+// Hits refresh the entry's mtime; after each store the least recently used entries
+// are evicted until the directory is back under max_bytes. Entries written with a
+// different HS_CACHE_VERSION are misses and get removed.
+static const uint32_t HS_CACHE_VERSION = 1; // bump whenever a cached solver's output changes
+static const char HS_CACHE_MAGIC[8] = {'H', 'S', 'C', 'A', 'C', 'H', 'E', '1'};
+
+struct CacheEntry
+{
+    vector<int> hitting_set;
+    int c_prime = 0;      // c' of the doubling round that produced it, 0 otherwise
+    int lower_bound = 0;  // anytime mode's lower bound, 0 otherwise
+    int ilp_optimum = -1; // optimum size if an ILP run proved it, -1 if unknown
+    double solve_ms = 0.0;
+};
+
+class SolutionCache
+{
+public:
+    SolutionCache(const string &dir, uint64_t max_bytes, const Graph &graph) : dir_(dir), max_bytes_(max_bytes)
+    {
+        instance_hash_ = instance_hash(graph, num_edges_);
+        n_ = graph.num_points;
+        m_ = graph.num_ranges;
+
+        error_code ec;
+        filesystem::create_directories(dir_, ec);
+    }
+
+    bool lookup(const string &tag, CacheEntry &entry)
+    {
+        string path = entry_path(tag);
+        ifstream in(path, ios::binary);
+        if (!in)
+            return false;
+        string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+
+        size_t pos = 0;
+        auto get = [&](void *out, size_t len)
+        {
+            if (pos + len > data.size())
+                return false;
+            memcpy(out, data.data() + pos, len);
+            pos += len;
+            return true;
+        };
+        char magic[8];
+        uint32_t version = 0, k = 0;
+        uint64_t stored_hash = 0, num_edges = 0;
+        int32_t n = 0, m = 0;
+        bool ok = get(magic, 8) && memcmp(magic, HS_CACHE_MAGIC, 8) == 0 &&
+                  get(&version, 4) && version == HS_CACHE_VERSION &&
+                  get(&stored_hash, 8) && get(&n, 4) && get(&m, 4) && get(&num_edges, 8) &&
+                  stored_hash == instance_hash_ && n == n_ && m == m_ && num_edges == num_edges_ &&
+                  get(&entry.c_prime, 4) && get(&entry.lower_bound, 4) && get(&entry.ilp_optimum, 4) &&
+                  get(&entry.solve_ms, 8) && get(&k, 4) && (uint64_t)k * 4 == data.size() - pos;
+        if (!ok)
+        {
+            error_code ec;
+            filesystem::remove(path, ec); // stale version, hash collision or torn file
+            return false;
+        }
+        entry.hitting_set.resize(k);
+        get(entry.hitting_set.data(), (size_t)k * 4);
+
+        error_code ec;
+        filesystem::last_write_time(path, filesystem::file_time_type::clock::now(), ec);
+        return true;
+    }
+
+    void store(const string &tag, const CacheEntry &entry)
+    {
+        string data;
+        auto put = [&](const void *in, size_t len)
+        { data.append(static_cast<const char *>(in), len); };
+        uint32_t k = entry.hitting_set.size();
+        int32_t n = n_, m = m_;
+        put(HS_CACHE_MAGIC, 8);
+        put(&HS_CACHE_VERSION, 4);
+        put(&instance_hash_, 8);
+        put(&n, 4);
+        put(&m, 4);
+        put(&num_edges_, 8);
+        put(&entry.c_prime, 4);
+        put(&entry.lower_bound, 4);
+        put(&entry.ilp_optimum, 4);
+        put(&entry.solve_ms, 8);
+        put(&k, 4);
+        put(entry.hitting_set.data(), (size_t)k * 4);
+
+        // Written aside and renamed so that readers never see a partial entry.
+        string path = entry_path(tag);
+        string tmp_path = path + ".tmp." + to_string(getpid());
+        {
+            ofstream out(tmp_path, ios::binary | ios::trunc);
+            if (!out.write(data.data(), data.size()))
+                return;
+        }
+        error_code ec;
+        filesystem::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            filesystem::remove(tmp_path, ec);
+            return;
+        }
+        evict();
+    }
+
+private:
+    string entry_path(const string &tag) const
+    {
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)instance_hash_);
+        return dir_ + "/" + hex + "-" + tag + ".hsc";
+    }
+
+    void evict()
+    {
+        vector<pair<filesystem::file_time_type, filesystem::path>> entries;
+        uint64_t total = 0;
+        error_code ec;
+        for (const auto &file : filesystem::directory_iterator(dir_, ec))
+        {
+            if (file.path().extension() != ".hsc")
+                continue;
+            uint64_t size = file.file_size(ec);
+            if (ec)
+                continue; // removed by a concurrent run
+            total += size;
+            entries.emplace_back(file.last_write_time(ec), file.path());
+        }
+        sort(entries.begin(), entries.end());
+        for (const auto &entry : entries)
+        {
+            if (total <= max_bytes_)
+                break;
+            uint64_t size = filesystem::file_size(entry.second, ec);
+            if (!ec && filesystem::remove(entry.second, ec))
+                total -= size;
+        }
+    }
+
+    string dir_;
+    uint64_t max_bytes_;
+    uint64_t instance_hash_ = 0;
+    uint64_t num_edges_ = 0;
+    int32_t n_ = 0;
+    int32_t m_ = 0;
+};
+
+#endif // SOLUTION_CACHE_H